@@ -103,6 +103,8 @@ rather than -initWithObjectGraphContext:. */
 - (void) handleSelect: (ETLayoutItem *)item;
 - (BOOL) canDeselect: (ETLayoutItem *)item;
 - (void) handleDeselect: (ETLayoutItem *)item;
+- (void) handleSelectItems: (NSArray *)items;
+- (void) handleDeselectItems: (NSArray *)items;
 
 /** @taskunit Generic Actions */
 
@@ -612,6 +612,79 @@ TODO: Problably remove, since it should be of any use and just adds complexity.
 	[item setNeedsDisplay: YES];
 }
 
+/* Returns the given items grouped by parent item.
+
+Items without a parent are ignored. */
+static NSMapTable *ItemsByParentItem(NSArray *items)
+{
+	NSMapTable *itemsByParent = [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsObjectPointerPersonality
+	                                                  valueOptions: NSPointerFunctionsStrongMemory];
+
+	for (ETLayoutItem *item in items)
+	{
+		ETLayoutItemGroup *parent = [item parentItem];
+
+		if (parent == nil)
+			continue;
+
+		NSMutableArray *parentItems = [itemsByParent objectForKey: parent];
+
+		if (parentItems == nil)
+		{
+			parentItems = [NSMutableArray array];
+			[itemsByParent setObject: parentItems forKey: parent];
+		}
+		[parentItems addObject: item];
+	}
+	return itemsByParent;
+}
+
+/** Sets the items as selected and marks them to be redisplayed.
+
+ETSelectTool calls this method when it selects several items at once, for 
+example with -[ETSelectTool selectAll:].
+
+The selection is updated once per parent item with 
+-[ETLayoutItemGroup selectItems:], and -handleSelect: is not called. A subclass 
+that overrides -handleSelect: to react to selection changes must override this 
+method too, to react to a selection change that involves several items. */
+- (void) handleSelectItems: (NSArray *)items
+{
+	NSMapTable *itemsByParent = ItemsByParentItem(items);
+
+	for (ETLayoutItemGroup *parent in itemsByParent)
+	{
+		[parent selectItems: [itemsByParent objectForKey: parent]];
+	}
+	for (ETLayoutItem *item in items)
+	{
+		[item setNeedsDisplay: YES];
+	}
+}
+
+/** Sets the items as not selected and marks them to be redisplayed.
+
+ETSelectTool calls this method when it deselects several items at once, for 
+example with -[ETSelectTool deselectAllWithItem:].
+
+The selection is updated once per parent item with 
+-[ETLayoutItemGroup deselectItems:], and -handleDeselect: is not called.
+
+See also -handleSelectItems:. */
+- (void) handleDeselectItems: (NSArray *)items
+{
+	NSMapTable *itemsByParent = ItemsByParentItem(items);
+
+	for (ETLayoutItemGroup *parent in itemsByParent)
+	{
+		[parent deselectItems: [itemsByParent objectForKey: parent]];
+	}
+	for (ETLayoutItem *item in items)
+	{
+		[item setNeedsDisplay: YES];
+	}
+}
+
 /* Generic Actions */
 
 /** Overrides to return YES if you want that items to which the receiver is 
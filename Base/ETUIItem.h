@@ -15,7 +15,7 @@
 #import <EtoileUI/ETResponder.h>
 #import <EtoileUI/ETStyle.h>
 
-@class ETDecoratorItem, ETLayoutItemGroup, ETView;
+@class ETDecoratorItem, ETLayoutItemGroup, ETRenderContext, ETView;
 
 /** Enum used internally by EtoileUI to synchronize supervisor view and item 
 properties. */
@@ -80,7 +80,7 @@ You must never subclass ETUIItem. ETUIItem ivars must be considered private. */
 
 /** @taskunit Drawing */
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
       dirtyRect: (NSRect)dirtyRect 
       inContext: (id)ctxt;
 
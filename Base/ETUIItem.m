@@ -223,7 +223,7 @@ needs some special redisplay policy. */
 }
 
 /** <override-subclass /> */
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
       dirtyRect: (NSRect)dirtyRect 
       inContext: (id)ctxt
 {
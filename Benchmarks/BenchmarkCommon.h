@@ -0,0 +1,61 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <Foundation/Foundation.h>
+#import <AppKit/AppKit.h>
+#import <UnitKit/UnitKit.h>
+#import <EtoileFoundation/Macros.h>
+#import <CoreObject/COObjectGraphContext.h>
+#import "ETLayoutExecutor.h"
+#import "ETLayoutItem.h"
+#import "ETLayoutItemGroup.h"
+#import "ETLayoutItemFactory.h"
+#import "ETUIObject.h"
+
+/** The environment variable to set the path of the JSON results file.
+
+By default, the results are written to EtoileUIBenchmarks.json in the current 
+directory. */
+#define ETBENCH_OUTPUT_ENV @"ETBENCH_OUTPUT"
+/** The environment variable to limit the number of items in the generated 
+item trees.
+
+By default, the benchmarks are run with 1k, 10k, 100k and 1M items. */
+#define ETBENCH_MAX_ITEMS_ENV @"ETBENCH_MAX_ITEMS"
+
+/** The principal class of the benchmark bundle built with 'make bench=yes'.
+
+The benchmarks are UnitKit test classes, and are run headless with 
+'ukrun EtoileUI.bundle' like the test suite. Once all the benchmarks have run, 
+the recorded results are written as JSON. */
+@interface BenchmarkCommon : NSObject
+{
+	ETLayoutItemFactory *itemFactory;
+}
+
++ (void) willRunTestSuite;
++ (void) didRunTestSuite;
+
+/** @taskunit Generating Item Trees */
+
++ (NSArray *) itemCounts;
+- (ETLayoutItemGroup *) itemGroupWithItemCount: (NSUInteger)nbOfItems;
+
+/** @taskunit Recording Results */
+
+- (void) recordBenchmark: (NSString *)aName
+                  layout: (NSString *)aLayoutName
+               itemCount: (NSUInteger)nbOfItems
+              usingBlock: (void (^)(void))aBlock;
+- (void) recordBenchmark: (NSString *)aName
+                  layout: (NSString *)aLayoutName
+               itemCount: (NSUInteger)nbOfItems
+              setUpBlock: (void (^)(void))aSetUpBlock
+              usingBlock: (void (^)(void))aBlock;
+
+@end
@@ -0,0 +1,177 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import "BenchmarkCommon.h"
+#import "ETApplication.h"
+#import "ETCompatibility.h"
+#include <float.h>
+
+static NSMutableArray *recordedResults = nil;
+
+@implementation BenchmarkCommon
+
+/* See +[TestCommon willRunTestSuite]. */
++ (void) willRunTestSuite
+{
+	id app = [ETApplication sharedApplication];
+
+	ETAssert([app isKindOfClass: [ETApplication class]]);
+
+	[app setUp];
+	recordedResults = [NSMutableArray new];
+}
+
++ (NSString *) outputPath
+{
+	NSString *path = [[NSProcessInfo processInfo] environment][ETBENCH_OUTPUT_ENV];
+	return (path != nil ? path : @"EtoileUIBenchmarks.json");
+}
+
++ (void) didRunTestSuite
+{
+	NSDictionary *report = @{ @"suite": @"EtoileUI",
+	                          @"date": [[NSDate date] description],
+	                          @"results": recordedResults };
+	NSError *error = nil;
+	NSData *data = [NSJSONSerialization dataWithJSONObject: report
+	                                               options: NSJSONWritingPrettyPrinted
+	                                                 error: &error];
+
+	if (data == nil || [data writeToFile: [self outputPath] atomically: YES] == NO)
+	{
+		ETLog(@"Failed to write benchmark results to %@ - %@", [self outputPath], error);
+		return;
+	}
+	ETLog(@"Wrote %lu benchmark results to %@",
+		(unsigned long)[recordedResults count], [self outputPath]);
+}
+
+- (id) init
+{
+	SUPERINIT;
+	[[ETLayoutExecutor sharedInstance] removeAllItems];
+	return self;
+}
+
+- (void) dealloc
+{
+	[[ETLayoutExecutor sharedInstance] removeAllItems];
+}
+
+#pragma mark Generating Item Trees -
+
+/** Returns the item counts of the generated item trees, from 1k to 1M items, 
+limited by the ETBENCH_MAX_ITEMS environment variable. */
++ (NSArray *) itemCounts
+{
+	NSString *maxString = [[NSProcessInfo processInfo] environment][ETBENCH_MAX_ITEMS_ENV];
+	NSUInteger max = (maxString != nil ? (NSUInteger)[maxString integerValue] : 1000000);
+	NSMutableArray *counts = [NSMutableArray array];
+
+	for (NSUInteger count = 1000; count <= max && count <= 1000000; count *= 10)
+	{
+		[counts addObject: @(count)];
+	}
+	return counts;
+}
+
+/** Returns a new item group with the given number of children, in a new 
+transient object graph context.
+
+The children have varied sizes and names, and are generated deterministically, 
+so the results remain comparable between runs. */
+- (ETLayoutItemGroup *) itemGroupWithItemCount: (NSUInteger)nbOfItems
+{
+	itemFactory = [ETLayoutItemFactory factoryWithObjectGraphContext: [COObjectGraphContext new]];
+
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroup];
+	NSMutableArray *items = [NSMutableArray arrayWithCapacity: nbOfItems];
+	unsigned int seed = 1;
+
+	for (NSUInteger i = 0; i < nbOfItems; i++)
+	{
+		ETLayoutItem *item = [itemFactory item];
+
+		seed = seed * 1103515245 + 12345;
+		[item setSize: NSMakeSize(20 + (seed >> 16) % 80, 20 + (seed >> 8) % 40)];
+		[item setName: [NSString stringWithFormat: @"Item %lu", (unsigned long)i]];
+		[items addObject: item];
+	}
+
+	[itemGroup setSize: NSMakeSize(1000, 800)];
+	[itemGroup addItems: items];
+	return itemGroup;
+}
+
+#pragma mark Recording Results -
+
+/** Runs the given block several times, then records the timings in the results 
+written by +didRunTestSuite.
+
+See -recordBenchmark:layout:itemCount:setUpBlock:usingBlock:. */
+- (void) recordBenchmark: (NSString *)aName
+                  layout: (NSString *)aLayoutName
+               itemCount: (NSUInteger)nbOfItems
+              usingBlock: (void (^)(void))aBlock
+{
+	[self recordBenchmark: aName
+	               layout: aLayoutName
+	            itemCount: nbOfItems
+	           setUpBlock: nil
+	           usingBlock: aBlock];
+}
+
+/** Runs the given block several times, then records the timings in the results 
+written by +didRunTestSuite.
+
+The set up block, when not nil, is run before each run and is not timed (e.g. 
+to discard caches that would turn the next runs into cache hits).
+
+The number of runs decreases as the number of items increases. */
+- (void) recordBenchmark: (NSString *)aName
+                  layout: (NSString *)aLayoutName
+               itemCount: (NSUInteger)nbOfItems
+              setUpBlock: (void (^)(void))aSetUpBlock
+              usingBlock: (void (^)(void))aBlock
+{
+	NSUInteger nbOfRuns = MAX(1, MIN(5, 100000 / nbOfItems));
+	NSTimeInterval min = DBL_MAX;
+	NSTimeInterval max = 0;
+	NSTimeInterval total = 0;
+
+	for (NSUInteger i = 0; i < nbOfRuns; i++)
+	{
+		if (aSetUpBlock != nil)
+		{
+			aSetUpBlock();
+		}
+
+		NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+
+		aBlock();
+
+		NSTimeInterval duration = [NSDate timeIntervalSinceReferenceDate] - start;
+
+		min = MIN(min, duration);
+		max = MAX(max, duration);
+		total += duration;
+	}
+
+	[recordedResults addObject: @{ @"benchmark": aName,
+	                               @"layout": aLayoutName,
+	                               @"itemCount": @(nbOfItems),
+	                               @"runs": @(nbOfRuns),
+	                               @"minSeconds": @(min),
+	                               @"meanSeconds": @(total / nbOfRuns),
+	                               @"maxSeconds": @(max) }];
+
+	ETLog(@"%@ %@ %lu items: %f s", aLayoutName, aName,
+		(unsigned long)nbOfItems, total / nbOfRuns);
+}
+
+@end
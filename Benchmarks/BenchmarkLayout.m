@@ -0,0 +1,154 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import "BenchmarkCommon.h"
+#import "ETColumnLayout.h"
+#import "ETComputedLayout.h"
+#import "ETFlowLayout.h"
+#import "ETFormLayout.h"
+#import "ETIconLayout.h"
+#import "ETLayout.h"
+#import "ETLineLayout.h"
+#import "ETRenderState.h"
+#import "ETCompatibility.h"
+#include <math.h>
+
+/* The number of hit tests timed together for -itemAtLocation: */
+#define NB_OF_LOCATIONS 1000
+
+@interface ETComputedLayout (Private)
+- (void) discardLayoutFingerprint;
+@end
+
+@interface BenchmarkLayout : BenchmarkCommon <UKTest>
+@end
+
+@implementation BenchmarkLayout
+
+/* Times the layout update phases for item trees of increasing size. */
+- (void) benchmarkLayoutClass: (Class)layoutClass
+{
+	NSString *layoutName = NSStringFromClass(layoutClass);
+
+	for (NSNumber *count in [[self class] itemCounts])
+	{
+		NSUInteger nbOfItems = [count unsignedIntegerValue];
+		ETLayoutItemGroup *itemGroup = [self itemGroupWithItemCount: nbOfItems];
+		ETLayout *layout = [layoutClass layoutWithObjectGraphContext: [itemGroup objectGraphContext]];
+
+		[itemGroup setLayout: layout];
+		[itemGroup updateLayoutIfNeeded];
+
+		NSArray *items = [itemGroup arrangedItems];
+		NSSize layoutSize = [layout layoutSize];
+
+		/* Every run must compute the layout rather than reusing the last one */
+		void (^discardMemoizedLayout)(void) = ^ ()
+		{
+			[[layout ifResponds] discardLayoutFingerprint];
+		};
+
+		[self recordBenchmark: @"renderWithItems:isNewContent:"
+		               layout: layoutName
+		            itemCount: nbOfItems
+		           setUpBlock: discardMemoizedLayout
+		           usingBlock: ^ ()
+		{
+			[layout renderWithItems: items isNewContent: YES];
+		}];
+
+		[self recordBenchmark: @"renderWithItems:isNewContent: (memoized)"
+		               layout: layoutName
+		            itemCount: nbOfItems
+		           usingBlock: ^ ()
+		{
+			[layout renderWithItems: items isNewContent: YES];
+		}];
+
+		[self recordBenchmark: @"ETLayoutExecutor execute"
+		               layout: layoutName
+		            itemCount: nbOfItems
+		           setUpBlock: discardMemoizedLayout
+		           usingBlock: ^ ()
+		{
+			[itemGroup setNeedsLayoutUpdate];
+			[[ETLayoutExecutor sharedInstance] execute];
+		}];
+
+		[self recordBenchmark: @"itemAtLocation:"
+		               layout: layoutName
+		            itemCount: nbOfItems
+		           usingBlock: ^ ()
+		{
+			for (NSUInteger i = 0; i < NB_OF_LOCATIONS; i++)
+			{
+				[layout itemAtLocation: NSMakePoint(fmod(i * 37.0, MAX(layoutSize.width, 1)),
+				                                    fmod(i * 53.0, MAX(layoutSize.height, 1)))];
+			}
+		}];
+
+		NSImage *image = [[NSImage alloc] initWithSize: [itemGroup size]];
+		__block ETRenderStatistics renderStatistics;
+
+		[self recordBenchmark: @"render:dirtyRect:inContext:"
+		               layout: layoutName
+		            itemCount: nbOfItems
+		           usingBlock: ^ ()
+		{
+			[image lockFocus];
+			ETResetRenderStatistics();
+			[itemGroup render: nil dirtyRect: [itemGroup bounds] inContext: nil];
+			renderStatistics = ETGetRenderStatistics();
+			[image unlockFocus];
+		}];
+
+		/* The allocations are measured on GNUstep only */
+		NSString *allocationCount = (renderStatistics.allocationCount != NSNotFound ?
+			[NSString stringWithFormat: @"%lu", (unsigned long)renderStatistics.allocationCount] : @"unknown");
+
+		ETLog(@"%@ render %lu items: %lu render states, %@ transform and path allocations per frame",
+			layoutName, (unsigned long)nbOfItems, (unsigned long)renderStatistics.renderStateCount,
+			allocationCount);
+
+		[self recordBenchmark: @"setExposedItems:"
+		               layout: layoutName
+		            itemCount: nbOfItems
+		           usingBlock: ^ ()
+		{
+			[itemGroup setExposedItems: @[]];
+			[itemGroup setExposedItems: items];
+		}];
+	}
+}
+
+- (void) testFlowLayout
+{
+	[self benchmarkLayoutClass: [ETFlowLayout class]];
+}
+
+- (void) testLineLayout
+{
+	[self benchmarkLayoutClass: [ETLineLayout class]];
+}
+
+- (void) testColumnLayout
+{
+	[self benchmarkLayoutClass: [ETColumnLayout class]];
+}
+
+- (void) testFormLayout
+{
+	[self benchmarkLayoutClass: [ETFormLayout class]];
+}
+
+- (void) testIconLayout
+{
+	[self benchmarkLayoutClass: [ETIconLayout class]];
+}
+
+@end
@@ -0,0 +1,71 @@
+/**
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <Foundation/Foundation.h>
+
+/** A drawing command recorded in a display list.
+
+The command draws in the current graphics context, with the geometry and
+drawing attributes captured when it was recorded. */
+typedef void (^ETDrawingCommand)(void);
+
+/** The values a display list output depends on, in addition to the style
+properties and the item properties. */
+typedef struct ETDisplayListInputs
+{
+	NSUInteger styleRevision;
+	NSRect contentBounds;
+	NSRect boundingBox;
+	BOOL flipped;
+	BOOL selected;
+	BOOL firstResponder;
+	BOOL drawsSelectionIndicator;
+	BOOL drawsFirstResponderIndicator;
+} ETDisplayListInputs;
+
+/** @abstract Drawing commands recorded while rendering a style group
+
+A display list is recorded the first time an item that returns YES to
+-[ETLayoutItem recordsDisplayList] is rendered, then replayed on the next
+redraws, so the styles don't recompute their label rects, image rects or
+shadow parameters.
+
+The styles record their drawing with -[ETRenderContext draw:]. Only the styles
+that return YES to -[ETStyle supportsDisplayList] can be recorded.
+
+The display list remembers the inputs it was recorded from. Once these inputs
+change, the display list must be discarded and recorded again, see
+-isValidForInputs:.
+
+ETDisplayList is not designed to be subclassed. */
+@interface ETDisplayList : NSObject
+{
+	@private
+	ETDisplayListInputs _inputs;
+	NSMutableArray *_commands;
+}
+
+/** @taskunit Initialization */
+
+- (instancetype) initWithInputs: (ETDisplayListInputs)inputs NS_DESIGNATED_INITIALIZER;
+
+/** @taskunit Recording */
+
+/** The inputs the display list was recorded from. */
+@property (nonatomic, readonly) ETDisplayListInputs inputs;
+/** The number of recorded commands. */
+@property (nonatomic, readonly) NSUInteger count;
+
+- (void) addCommand: (ETDrawingCommand)aCommand;
+- (BOOL) isValidForInputs: (ETDisplayListInputs)inputs;
+
+/** @taskunit Replaying */
+
+- (void) replay;
+
+@end
@@ -82,7 +82,7 @@ the resize tool more straightforward to use for the user. */
 @property (nonatomic, readonly) ETHandle *topHandle;
 @property (nonatomic, readonly) ETHandle *bottomHandle;
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
 	  dirtyRect: (NSRect)dirtyRect
       inContext: (id)ctxt;
 - (void) drawOutlineInRect: (NSRect)rect;
@@ -0,0 +1,74 @@
+/**
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <Foundation/Foundation.h>
+#import <EtoileUI/ETGraphicsBackend.h>
+
+@class ETLayoutItem;
+
+/** @abstract A service that decodes item images on background threads
+
+An image loader reads, decodes and downscales image files on background 
+threads, then sets the resulting images on the items with 
+-[ETLayoutItem setValue:forProperty:] and kETImageProperty. When the item 
+represented object declares an image property, the image is set on the 
+represented object, otherwise on the item.
+
+Until its image is ready, each item shows -placeholderImage through its image 
+property.
+
+The loaded images are delivered to the main thread in batches. Once a batch 
+has been set on the items, the parent items are redisplayed once.
+
+Visible items are decoded first (see -[ETLayoutItem isVisible]). The loader 
+checks the item visibility when a load is requested and each time a batch is 
+delivered, so items scrolled into view are moved to the front of the pending 
+loads.
+
+Except the decoding, the loader must be used from the main thread.
+
+ETImageLoader is not designed to be subclassed. */
+@interface ETImageLoader : NSObject
+{
+	@private
+	NSOperationQueue *_queue;
+	NSMapTable *_operationsByItem;
+	NSMutableArray *_loadedImages;
+	BOOL _isDeliveryScheduled;
+	NSImage *_placeholderImage;
+	NSSize _maxImageSize;
+}
+
+/** @taskunit Initialization */
+
++ (instancetype) sharedInstance;
+
+/** @taskunit Loading Images */
+
+- (void) loadImageAtPath: (NSString *)aPath forItem: (ETLayoutItem *)anItem;
+- (void) cancelLoadingForItem: (ETLayoutItem *)anItem;
+- (BOOL) isLoadingForItem: (ETLayoutItem *)anItem;
+
+/** The image set on the items while their image is decoded.
+
+By default, nil. */
+@property (nonatomic, strong) NSImage *placeholderImage;
+/** The max size in pixels to which the decoded images are downscaled, keeping 
+their aspect ratio.
+
+ETNullSize means the images are not downscaled.
+
+By default, 512 x 512. */
+@property (nonatomic) NSSize maxImageSize;
+
+/** @taskunit Delivering Loaded Images */
+
+- (void) deliverLoadedImages;
+- (void) waitUntilAllImagesAreLoaded;
+
+@end
@@ -40,6 +40,16 @@
  
  - (ETWindowItem *) provideWindowItem;
 
+/** @taskunit Parent Item Integration */
+
+@property (nonatomic) NSUInteger cachedIndexInParentItem;
+
+/** @taskunit Opaque Layout Integration */
+
+- (void) invalidateOpaqueLayoutForValueChanges;
+- (BOOL) hasCachedOpaqueLayout;
+- (ETLayout *) opaqueLayoutForValueChanges;
+
 /** @taskunit Visibility and Layout Interaction */
 
 @property (nonatomic, getter=isExposed) BOOL exposed;
@@ -62,13 +72,13 @@
 
 /** @taskunit Drawing */
 
-- (void) render: (NSMutableDictionary *)inputValues
+- (void) render: (ETRenderContext *)renderContext
       dirtyRect: (NSRect)dirtyRect
       inContext: (id)ctxt;
-- (void) renderBackground: (NSMutableDictionary *)inputValues
+- (void) renderBackground: (ETRenderContext *)renderContext
                 dirtyRect: (NSRect)dirtyRect
                 inContext: (id)ctxt;
-- (void) renderForeground: (NSMutableDictionary *)inputValues
+- (void) renderForeground: (ETRenderContext *)renderContext
                 dirtyRect: (NSRect)dirtyRect
                 inContext: (id)ctxt;
 
@@ -19,7 +19,7 @@
 
 @class ETUTI;
 @class ETItemValueTransformer, ETView, ETLayout, ETLayoutItemGroup,
-ETDecoratorItem, ETScrollableAreaItem, ETWindowItem, ETActionHandler, ETStyleGroup;
+ETDecoratorItem, ETDisplayList, ETScrollableAreaItem, ETWindowItem, ETActionHandler, ETRenderContext, ETStyleGroup;
 @protocol ETWidget, NSValidatedUserInterfaceItem;
 
 /** Describes how the item is resized when its parent item is resized.
@@ -135,6 +135,13 @@ and centers it. A strech is a scale that doesn't preserve the content proportion
 	BOOL _isSyncingViewValue;
 	BOOL _isEditing; /* Used by ETLayoutItem+AppKit */
 	BOOL _isEditingUI; /* Used by ETLayoutItem+CoreObject */
+	/* Index in the parent item, see -[ETLayoutItemGroup indexOfItem:] */
+	NSUInteger _cachedIndexInParentItem;
+	BOOL _recordsDisplayList;
+	ETDisplayList *_displayList;
+	/* Closest ancestor opaque layout, see -opaqueLayoutForValueChanges */
+	ETLayout * __weak _opaqueLayout;
+	BOOL _hasCachedOpaqueLayout;
 	@protected
 	BOOL _isDeallocating;
 }
@@ -246,7 +253,7 @@ If a host item is set, returns -hostItem. */
 /** @taskunit Drawing */
 
 - (NSRect) drawingBoundsForStyle: (ETStyle *)aStyle;
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
       dirtyRect: (NSRect)dirtyRect 
       inContext: (id)ctxt;
 
@@ -259,6 +266,23 @@ If a host item is set, returns -hostItem. */
 - (id) coverStyle;
 - (void) setCoverStyle: (ETStyle *)aStyle;
 
+/** @task Display Lists */
+
+/** Whether the style group output is recorded into a display list, then 
+replayed on the next redraws until the display list becomes invalid.
+
+The display list is only used when -[ETStyle supportsDisplayList] returns YES 
+for the style group.
+
+This property is transient and not persisted. By default, returns NO.
+
+See also ETDisplayList and -discardDisplayList. */
+@property (nonatomic) BOOL recordsDisplayList;
+/** The display list recorded on the last redraw, or nil. */
+@property (nonatomic, readonly) ETDisplayList *displayList;
+
+- (void) discardDisplayList;
+
 /** @taskunit Display Update */
 
 - (void) setNeedsDisplay: (BOOL)flag;
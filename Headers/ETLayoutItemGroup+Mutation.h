@@ -39,6 +39,9 @@ like -addItem, removeItem:, -insertItem:atIndex: etc. */
 
 @property (nonatomic) BOOL hasNewContent;
 - (void) didChangeContentWithMoreComing: (BOOL)moreComing;
+@property (nonatomic, readonly) NSIndexSet *insertedItemIndexes;
+@property (nonatomic, readonly) NSIndexSet *removedItemIndexes;
+- (void) discardContentChanges;
 @property (nonatomic, getter=isCoalescingModelMutation, readonly) BOOL coalescingModelMutation;
 - (void) beginCoalescingModelMutation;
 - (void) endCoalescingModelMutation;
@@ -10,6 +10,8 @@
 #import <EtoileFoundation/ETCollection.h>
 #import <EtoileUI/ETLayoutItemGroup.h>
 
+@class ETSelectionModel, ETSpatialIndex;
+
 @interface ETLayoutItemGroup ()
 
 /** @task Reloading Descendant Items */
@@ -22,9 +24,7 @@
 
 - (void) attachItems: (NSArray *)items atIndexes: (NSIndexSet *)indexes;
 - (void) detachItems: (NSArray *)items atIndexes: (NSIndexSet *)indexes;
-- (void) updateExposedViewsForItems: (NSArray *)items
-                     exposedIndexes: (NSIndexSet *)exposedIndexes
-                   unexposedIndexes: (NSIndexSet *)unexposedIndexes;
+- (void) updateExposedViewsForItems: (NSArray *)items;
 - (void) setUpSupervisorViewsForNewItemsIfNeeded: (NSArray *)items;
 
 /** @taskunit Mutation Notifications */
@@ -32,6 +32,21 @@
 - (void) didAttachItem: (ETLayoutItem *)item;
 - (void) didDetachItem: (ETLayoutItem *)item;
 
+/** @taskunit Spatial Index */
+
+@property (nonatomic, readonly) ETSpatialIndex *spatialIndex;
+
+- (void) invalidateSpatialIndex;
+- (void) didChangeGeometryOfItem: (ETLayoutItem *)anItem;
+
+/** @taskunit Selection Model */
+
+@property (nonatomic, readonly) ETSelectionModel *selectionModel;
+@property (nonatomic, readonly) BOOL hasSelectedDescendants;
+
+- (void) discardSelectionModel;
+- (void) didChangeSelectionStateOfItem: (ETLayoutItem *)anItem;
+
 /** @taskunit Selection Notifications */
 
 - (void) didChangeSelection;
@@ -17,7 +17,7 @@
 #import <EtoileUI/ETLayout.h>
 #import <EtoileUI/ETWidgetLayout.h>
 
-@class ETController;
+@class ETController, ETSelectionModel, ETSpatialIndex;
 
 /** You must never subclass ETLayoutItemGroup. */
 @interface ETLayoutItemGroup : ETLayoutItem <ETLayoutingContext, ETWidgetLayoutingContext, ETItemSelection, ETCollection, ETCollectionMutation>
@@ -28,10 +28,17 @@
 	NSArray *_arrangedItems;
 	ETLayout *_layout;
 	NSImage *_cachedDisplayImage;
+	ETSpatialIndex *_spatialIndex;
+	ETSelectionModel *_selectionModel;
 	SEL _doubleAction;
 	BOOL _reloading; /* ivar used by ETMutationHandler category */
 	BOOL _mutating; /* ivar used by ETMutationHandler category */
 	BOOL _hasNewContent;
+	/* Row-level changes since the last layout update, see 
+	   -insertedItemIndexes in ETMutationHandler category */
+	NSMutableIndexSet *_insertedItemIndexes;
+	NSMutableIndexSet *_removedItemIndexes;
+	BOOL _hasUntrackedContentChanges;
 	BOOL _hasNewLayout;
 	/* Indicates whether -arrangedItems has changed since the layout was last
        updated. Sets to YES when the receiver is filtered and/or sorted. */
@@ -44,6 +51,7 @@
 	   must restore [[[self supervisorView] wrappedView] isHidden] correctly. */
 	BOOL _wasViewHidden;
 	BOOL _changingSelection;
+	BOOL _needsSpatialIndexRebuild;
 }
 
 /** @taskunit Traversing the Layout Item Tree */
@@ -115,10 +123,12 @@
 
 /** @taskunit Drawing */
 
-- (void) render: (NSMutableDictionary *)inputValues
+- (void) render: (ETRenderContext *)renderContext
       dirtyRect: (NSRect)dirtyRect
       inContext: (id)ctxt;
 
+@property (nonatomic) BOOL usesSpatialIndex;
+
 /** @taskunit Selection */
 
 @property (nonatomic) NSUInteger selectionIndex;
@@ -129,12 +139,21 @@
 @property (nonatomic) NSArray *selectedItems;
 @property (nonatomic, readonly) NSArray *selectedItemsInLayout;
 
+- (void) selectItems: (NSArray *)items;
+- (void) deselectItems: (NSArray *)items;
+- (void) deselectAll;
+
 /** @taskunit Sorting and Filtering */
 
 - (void) sortWithSortDescriptors: (NSArray *)descriptors recursively: (BOOL)recursively;
 - (void) filterWithPredicate: (NSPredicate *)predicate recursively: (BOOL)recursively;
 
 @property (nonatomic, readonly) NSArray *arrangedItems;
+@property (nonatomic, readonly) NSUInteger numberOfArrangedItems;
+
+- (ETLayoutItem *) arrangedItemAtIndex: (NSUInteger)index;
+- (NSUInteger) indexOfArrangedItem: (ETLayoutItem *)anItem;
+
 @property (nonatomic, getter=isSorted, readonly) BOOL sorted;
 @property (nonatomic, getter=isFiltered, readonly) BOOL filtered;
 
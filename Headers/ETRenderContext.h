@@ -0,0 +1,186 @@
+/**
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <Foundation/Foundation.h>
+#import <EtoileUI/ETDisplayList.h>
+#import <EtoileUI/ETRenderState.h>
+
+/** The render context state saved by -[ETRenderContext pushRenderState:]. */
+typedef struct ETRenderContextState
+{
+	/** The render state pushed, to undo it in -popRenderState. */
+	ETRenderState renderState;
+	NSAffineTransformStruct transform;
+	NSRect clipRect;
+	NSRect dirtyRect;
+} ETRenderContextState;
+
+/** @abstract The state carried downwards while rendering an item tree
+
+A render context is created by the supervisor view or the item on which the
+rendering starts, then passed to every -[ETLayoutItem render:dirtyRect:inContext:],
+-[ETLayoutItem renderBackground:dirtyRect:inContext:] and
+-[ETStyle render:layoutItem:dirtyRect:] call, until the rendering is finished.
+
+The render context exposes typed properties, so styles can query the dirty
+rect, the transform, the clip, the selection drawing flags or the scale factor
+without any dictionary lookup.
+
+While rendering, the transform and the clip are updated with
+-pushRenderState: and -popRenderState, which also adjust the current graphics
+context with ETPushRenderState() and ETPopRenderState().
+
+A render context can be reused from one frame to the next, but 
+-resetWithInputValues: must be called before each frame, so no state set while 
+drawing the previous frame leaks into the next one.
+
+@section Backward Compatibility
+
+Until now, the rendering methods received an NSMutableDictionary named
+inputValues, carrying arbitrary key/value pairs. The render context keeps
+these pairs in -inputValues, and responds to -objectForKey:,
+-setObject:forKey:, -removeObjectForKey:, -count, -keyEnumerator, the 
+subscripting methods and fast enumeration, so styles written against the 
+dictionary keep working. Other NSMutableDictionary messages must be sent to 
+-inputValues.
+
+The rendering entry points accept a plain dictionary or nil, and convert it
+with +renderContextWithInputValues: or ETRenderContextFromInputValues().
+
+ETRenderContext is not designed to be subclassed. */
+@interface ETRenderContext : NSObject <NSFastEnumeration>
+{
+	@private
+	NSMutableDictionary *_inputValues;
+	ETDisplayList *_recordingDisplayList;
+	ETRenderContextState *_stateStack;
+	NSUInteger _stateCount;
+	NSUInteger _stateCapacity;
+	NSAffineTransformStruct _transform;
+	NSRect _clipRect;
+	NSRect _dirtyRect;
+	BOOL _drawsSelectionIndicator;
+	BOOL _drawsFirstResponderIndicator;
+	CGFloat _scaleFactor;
+}
+
+/** @taskunit Initialization */
+
++ (ETRenderContext *) renderContextWithInputValues: (NSDictionary *)inputValues;
+
+- (void) resetWithInputValues: (NSDictionary *)inputValues;
+
+
+/** @taskunit Rendering State */
+
+/** The area to redraw, expressed in the coordinate space of the item being
+rendered.
+
+Usually equal to the clip rect, but can be set independently. By default,
+returns ETNullRect. */
+@property (nonatomic) NSRect dirtyRect;
+/** The transform from the coordinate space where the rendering started, to
+the coordinate space of the item being rendered.
+
+See -pushRenderState:. */
+@property (nonatomic, readonly) NSAffineTransformStruct transform;
+/** The clip rect, expressed in the coordinate space of the item being
+rendered.
+
+Each clip rect pushed with -pushRenderState: is intersected with the current 
+one.
+
+By default, returns ETNullRect to indicate there is no clip. */
+@property (nonatomic, readonly) NSRect clipRect;
+
+- (void) pushRenderState: (ETRenderState)aState;
+- (void) popRenderState;
+
+/** @taskunit Drawing Options */
+
+/** Whether the styles should draw a selection indicator for selected items.
+
+Set by the parent item based on
+-[ETLayout preventsDrawingItemSelectionIndicator], before rendering its
+children.
+
+By default, returns YES. */
+@property (nonatomic) BOOL drawsSelectionIndicator;
+/** Whether the styles should draw a first responder indicator.
+
+By default, returns YES. */
+@property (nonatomic) BOOL drawsFirstResponderIndicator;
+/** The number of device pixels per point.
+
+Can be used to pick images or align drawing on device pixels.
+
+ETView sets it to the window backing scale factor, every time it starts to 
+redraw. By default, returns 1. */
+@property (nonatomic) CGFloat scaleFactor;
+
+/** @taskunit Recording Display Lists */
+
+/** The display list in which -draw: records the drawing commands.
+
+When nil, -draw: just executes the commands. */
+@property (nonatomic, strong) ETDisplayList *recordingDisplayList;
+
+- (void) draw: (ETDrawingCommand)aCommand;
+
+/** @taskunit Input Values */
+
+/** The key/value pairs set by code that still treats the render context as
+an inputValues dictionary.
+
+Never returns nil. */
+@property (nonatomic, readonly) NSMutableDictionary *inputValues;
+
+- (id) objectForKey: (id)aKey;
+- (void) setObject: (id)anObject forKey: (id <NSCopying>)aKey;
+- (void) removeObjectForKey: (id)aKey;
+- (id) objectForKeyedSubscript: (id)aKey;
+- (void) setObject: (id)anObject forKeyedSubscript: (id <NSCopying>)aKey;
+- (NSUInteger) count;
+- (NSEnumerator *) keyEnumerator;
+
+@end
+
+/** Returns the given render context, or a render context that contains the 
+key/value pairs when a plain inputValues dictionary is passed (see 
++[ETRenderContext renderContextWithInputValues:]).
+
+Unlike +renderContextWithInputValues:, returns nil for nil, so styles rendered 
+without a render context are still drawn directly.
+
+Styles that use the render context properties or ETDraw() must call this 
+function first in -[ETStyle render:layoutItem:dirtyRect:], since callers written 
+against the inputValues dictionary can still pass a dictionary. */
+static inline ETRenderContext *ETRenderContextFromInputValues(id inputValues)
+{
+	if (inputValues == nil || [inputValues isKindOfClass: [ETRenderContext class]])
+		return inputValues;
+
+	return [ETRenderContext renderContextWithInputValues: inputValues];
+}
+
+/** Executes the given drawing command with -[ETRenderContext draw:], or 
+directly when the render context is nil.
+
+Styles should use this function rather than -draw:, since they can be 
+rendered without a render context. */
+static inline void ETDraw(ETRenderContext *renderContext, ETDrawingCommand aCommand)
+{
+	if (renderContext != nil)
+	{
+		[renderContext draw: aCommand];
+	}
+	else
+	{
+		aCommand();
+	}
+}
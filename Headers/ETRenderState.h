@@ -0,0 +1,156 @@
+/**
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <Foundation/Foundation.h>
+#import <EtoileUI/ETGraphicsBackend.h>
+#import <AppKit/NSAffineTransform.h>
+#import <EtoileUI/ETGeometry.h>
+
+/** @abstract A transform and clip rect to apply to the current graphics context
+
+A render state is a plain struct that describes how the coordinates matrix and
+the clip must be adjusted to draw an item or a part of it.
+
+Unlike NSAffineTransform and NSBezierPath, the render state is built without
+any Objective-C allocation. When it has no clip rect, the graphics state is not
+saved, the transform is concatenated and then undone by concatenating its
+inverse, as -[ETLayoutItemGroup render:item:dirtyRect:inContext:] used to do
+with NSAffineTransform.
+
+Apply a render state with ETPushRenderState(), and undo it with
+ETPopRenderState() once the drawing is done. */
+typedef struct ETRenderState
+{
+	/** The transform to concatenate to the current coordinates matrix. */
+	NSAffineTransformStruct transform;
+	/** The clip rect expressed in the transformed coordinate space.
+
+	When set to ETNullRect, the clip is left untouched. */
+	NSRect clipRect;
+} ETRenderState;
+
+/** Returns the identity transform. */
+static inline NSAffineTransformStruct ETIdentityTransform(void)
+{
+	NSAffineTransformStruct transform = { 1, 0, 0, 1, 0, 0 };
+	return transform;
+}
+
+/** Returns the given transform translated by dx and dy.
+
+Just like -[NSAffineTransform translateXBy:yBy:], the translation is expressed
+in the coordinate space of the given transform. */
+static inline NSAffineTransformStruct ETTranslatedTransform(NSAffineTransformStruct transform, CGFloat dx, CGFloat dy)
+{
+	transform.tX += transform.m11 * dx + transform.m21 * dy;
+	transform.tY += transform.m12 * dx + transform.m22 * dy;
+	return transform;
+}
+
+/** Returns the given transform scaled by sx and sy.
+
+Just like -[NSAffineTransform scaleXBy:yBy:], the scaling is expressed in the
+coordinate space of the given transform. */
+static inline NSAffineTransformStruct ETScaledTransform(NSAffineTransformStruct transform, CGFloat sx, CGFloat sy)
+{
+	transform.m11 *= sx;
+	transform.m12 *= sx;
+	transform.m21 *= sy;
+	transform.m22 *= sy;
+	return transform;
+}
+
+/** Returns the given transform flipped vertically around a coordinate space
+whose height is the given one. */
+static inline NSAffineTransformStruct ETFlippedTransform(NSAffineTransformStruct transform, CGFloat height)
+{
+	return ETScaledTransform(ETTranslatedTransform(transform, 0, height), 1, -1);
+}
+
+/** Returns whether the given transform can be inverted. */
+static inline BOOL ETIsInvertibleTransform(NSAffineTransformStruct t)
+{
+	return (t.m11 * t.m22 - t.m12 * t.m21 != 0);
+}
+
+/** Returns the inverse of the given transform.
+
+The transform must be invertible, see ETIsInvertibleTransform(). */
+static inline NSAffineTransformStruct ETInvertedTransform(NSAffineTransformStruct t)
+{
+	CGFloat det = t.m11 * t.m22 - t.m12 * t.m21;
+	NSAffineTransformStruct inverse = { t.m22 / det, -t.m12 / det, -t.m21 / det, t.m11 / det, 0, 0 };
+
+	inverse.tX = -(t.tX * inverse.m11 + t.tY * inverse.m21);
+	inverse.tY = -(t.tX * inverse.m12 + t.tY * inverse.m22);
+	return inverse;
+}
+
+/** Returns the transform that applies the given transform, then the other
+transform.
+
+Just like -[NSAffineTransform appendTransform:] does. */
+static inline NSAffineTransformStruct ETConcatenatedTransform(NSAffineTransformStruct transform, NSAffineTransformStruct otherTransform)
+{
+	NSAffineTransformStruct result;
+
+	result.m11 = transform.m11 * otherTransform.m11 + transform.m12 * otherTransform.m21;
+	result.m12 = transform.m11 * otherTransform.m12 + transform.m12 * otherTransform.m22;
+	result.m21 = transform.m21 * otherTransform.m11 + transform.m22 * otherTransform.m21;
+	result.m22 = transform.m21 * otherTransform.m12 + transform.m22 * otherTransform.m22;
+	result.tX = transform.tX * otherTransform.m11 + transform.tY * otherTransform.m21 + otherTransform.tX;
+	result.tY = transform.tX * otherTransform.m12 + transform.tY * otherTransform.m22 + otherTransform.tY;
+	return result;
+}
+
+/** Returns a render state that translates the coordinates matrix to the given
+rect origin, optionally flipped vertically, and clips the drawing to the given
+clip rect.
+
+The clip rect is expressed in the translated coordinate space. */
+static inline ETRenderState ETRenderStateMake(NSRect aRect, BOOL flipped, NSRect clipRect)
+{
+	NSAffineTransformStruct transform =
+		ETTranslatedTransform(ETIdentityTransform(), aRect.origin.x, aRect.origin.y);
+
+	if (flipped)
+	{
+		transform = ETFlippedTransform(transform, aRect.size.height);
+	}
+	return (ETRenderState){ transform, clipRect };
+}
+
+/** @taskunit Applying Render States */
+
+extern void ETPushRenderState(ETRenderState state);
+extern void ETPopRenderState(ETRenderState state);
+extern NSRect ETRectInTransformedSpace(NSRect aRect, NSAffineTransformStruct transform);
+
+/** @taskunit Render Statistics */
+
+/** The statistics collected while rendering, usually per frame. */
+typedef struct ETRenderStatistics
+{
+	/** The number of render states pushed with ETPushRenderState(). */
+	NSUInteger renderStateCount;
+	/** The number of NSAffineTransform and NSBezierPath instances allocated, 
+	as measured with GSDebugAllocationTotal().
+
+	NSNotFound when the allocations cannot be measured, which is the case on 
+	Mac OS X. */
+	NSUInteger allocationCount;
+	/** The number of item renderings that replayed a recorded display list. */
+	NSUInteger displayListHitCount;
+	/** The number of item renderings that recorded a display list, because 
+	there was none or it was invalid. */
+	NSUInteger displayListMissCount;
+} ETRenderStatistics;
+
+extern ETRenderStatistics ETGetRenderStatistics(void);
+extern void ETResetRenderStatistics(void);
+extern void ETRecordDisplayListLookup(BOOL isHit);
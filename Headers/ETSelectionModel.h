@@ -0,0 +1,54 @@
+/**
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <Foundation/Foundation.h>
+
+@class ETLayoutItem, ETLayoutItemGroup;
+
+/** @abstract The selection state of an item group subtree
+
+A selection model tracks which children are selected in an item group, and
+which child item groups contain selected descendant items.
+
+Each item group owns a selection model, built lazily from the -selected
+property of its children, then kept in sync by -[ETLayoutItem setSelected:]
+and the item group mutations. Querying the selection then costs O(k), where k
+is the number of selected items, rather than O(n) for the whole subtree.
+
+The selected items are not ordered, the item group orders them with
+-[ETLayoutItemGroup indexOfItem:] when needed.
+
+ETSelectionModel is not designed to be subclassed. */
+@interface ETSelectionModel : NSObject
+{
+	@private
+	NSHashTable *_selectedItems;
+	NSHashTable *_itemsWithSelectedDescendants;
+}
+
+/** @taskunit Updating the Selection State */
+
+- (void) updateItem: (ETLayoutItem *)anItem;
+- (void) removeItem: (ETLayoutItem *)anItem;
+
+/** @taskunit Querying the Selection State */
+
+/** Returns whether no children or descendant items are selected. */
+@property (nonatomic, readonly, getter=isEmpty) BOOL empty;
+/** Returns the selected children.
+
+The returned collection is not ordered. */
+@property (nonatomic, readonly) NSArray *selectedItems;
+/** Returns the child item groups that contain selected descendant items.
+
+The returned collection is not ordered. */
+@property (nonatomic, readonly) NSArray *itemsWithSelectedDescendants;
+
+- (BOOL) isSelectedItem: (ETLayoutItem *)anItem;
+
+@end
@@ -0,0 +1,68 @@
+/**
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <Foundation/Foundation.h>
+#import <EtoileUI/ETGraphicsBackend.h>
+
+@class ETLayoutItem;
+
+/** @abstract A uniform grid that indexes item rects to query them by area
+
+A spatial index lets an item group find the children that intersect a rect 
+without visiting every child. Each indexed item is registered in every grid 
+cell its rect overlaps, so a query only visits the items inside the cells 
+covered by the queried rect.
+
+Each item is indexed with an order, usually its index in 
+-[ETLayoutItemGroup arrangedItems]. Queries return the items sorted by 
+decreasing order, which matches the child drawing order.
+
+Indexed items are retained until they are removed, so -removeItem: or 
+-removeAllItems must be called when items go away.
+
+An item whose rect is not finite, or covers too many cells, is not registered 
+in the grid but kept apart, and checked by every query.
+
+ETSpatialIndex is not designed to be subclassed. */
+@interface ETSpatialIndex : NSObject
+{
+	@private
+	NSSize _cellSize;
+	NSMutableDictionary *_cells;
+	NSMapTable *_entries;
+	NSMutableSet *_overflowEntries;
+	NSUInteger _queryStamp;
+}
+
+/** @taskunit Initialization */
+
+- (instancetype) initWithCellSize: (NSSize)aSize NS_DESIGNATED_INITIALIZER;
+
+/** The size of each grid cell.
+
+By default, 256 x 256. */
+@property (nonatomic, readonly) NSSize cellSize;
+
+/** @taskunit Indexing Items */
+
+- (void) setRect: (NSRect)aRect order: (NSUInteger)anOrder forItem: (ETLayoutItem *)anItem;
+- (void) setRect: (NSRect)aRect forItem: (ETLayoutItem *)anItem;
+- (void) removeItem: (ETLayoutItem *)anItem;
+- (void) removeAllItems;
+
+- (BOOL) containsItem: (ETLayoutItem *)anItem;
+- (NSRect) rectForItem: (ETLayoutItem *)anItem;
+
+/** The number of indexed items. */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** @taskunit Querying Items */
+
+- (NSArray *) itemsIntersectingRect: (NSRect)aRect;
+
+@end
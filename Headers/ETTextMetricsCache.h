@@ -0,0 +1,64 @@
+/**
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <Foundation/Foundation.h>
+#import <EtoileUI/ETGraphicsBackend.h>
+
+@class ETTextMetricsEntry;
+
+/** @abstract A bounded cache of string sizes measured with text attributes
+
+A text metrics cache remembers the size returned by -sizeWithAttributes: for 
+each string and attribute dictionary pair, so repeated labels are measured once 
+across styles and layouts.
+
+When the cache is full, the least recently used size is evicted.
+
+The cache is not thread-safe and must be used from the main thread.
+
+ETTextMetricsCache is not designed to be subclassed. */
+@interface ETTextMetricsCache : NSObject
+{
+	@private
+	NSUInteger _capacity;
+	NSUInteger _count;
+	NSMutableDictionary *_entriesByAttributes;
+	ETTextMetricsEntry *_mostRecentEntry;
+	ETTextMetricsEntry *_leastRecentEntry;
+	NSUInteger _hitCount;
+	NSUInteger _missCount;
+}
+
+/** @taskunit Initialization */
+
++ (instancetype) sharedInstance;
+
+- (instancetype) initWithCapacity: (NSUInteger)aCapacity NS_DESIGNATED_INITIALIZER;
+
+/** The max number of sizes kept in the cache.
+
+By default, 1024 for the shared instance. */
+@property (nonatomic, readonly) NSUInteger capacity;
+/** The number of sizes in the cache. */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** @taskunit Measuring Text */
+
+- (NSSize) sizeOfString: (NSString *)aString withAttributes: (NSDictionary *)attributes;
+- (void) removeAllSizes;
+
+/** @taskunit Statistics */
+
+/** The number of -sizeOfString:withAttributes: calls answered by the cache. */
+@property (nonatomic, readonly) NSUInteger hitCount;
+/** The number of -sizeOfString:withAttributes: calls that measured the string. */
+@property (nonatomic, readonly) NSUInteger missCount;
+
+- (void) resetStatistics;
+
+@end
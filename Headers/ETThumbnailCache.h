@@ -0,0 +1,76 @@
+/**
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <Foundation/Foundation.h>
+#import <EtoileUI/ETGraphicsBackend.h>
+
+@class ETThumbnailEntry;
+
+/** @abstract A bounded cache of downscaled images
+
+A thumbnail cache keeps scaled down copies of images, so drawing a large image 
+in a small rect doesn't rescale the original on every repaint.
+
+For each image, the thumbnails are organized in levels whose largest side is a 
+power of two in device pixels (16, 32, 64 etc.). A thumbnail request returns the smallest level 
+that covers the requested size, so zooming reuses the same few levels rather 
+than rescaling the original for every intermediate size.
+
+The cache evicts the least recently used thumbnails once the memory they use 
+exceeds -maxMemoryCost. The memory cost of a thumbnail is estimated as four 
+bytes per pixel.
+
+The images are identified by their address and are not retained by the cache. 
+When an image is mutated, -removeThumbnailsForImage: must be called.
+
+The cache is not thread-safe and must be used from the main thread.
+
+ETThumbnailCache is not designed to be subclassed. */
+@interface ETThumbnailCache : NSObject
+{
+	@private
+	NSUInteger _maxMemoryCost;
+	NSUInteger _memoryCost;
+	NSMapTable *_levelsByImage;
+	ETThumbnailEntry *_mostRecentEntry;
+	ETThumbnailEntry *_leastRecentEntry;
+	NSUInteger _hitCount;
+	NSUInteger _missCount;
+}
+
+/** @taskunit Initialization */
+
++ (instancetype) sharedInstance;
+
+/** @taskunit Memory Budget */
+
+/** The max number of bytes used by the thumbnails.
+
+Lowering the budget evicts thumbnails immediately.
+
+By default, 64 MB. */
+@property (nonatomic) NSUInteger maxMemoryCost;
+/** The number of bytes used by the thumbnails. */
+@property (nonatomic, readonly) NSUInteger memoryCost;
+
+/** @taskunit Thumbnails */
+
+- (NSImage *) thumbnailForImage: (NSImage *)anImage fittingPixelSize: (NSSize)aSize;
+- (void) removeThumbnailsForImage: (NSImage *)anImage;
+- (void) removeAllThumbnails;
+
+/** @taskunit Statistics */
+
+/** The number of thumbnail requests answered by the cache. */
+@property (nonatomic, readonly) NSUInteger hitCount;
+/** The number of thumbnail requests that rescaled the original image. */
+@property (nonatomic, readonly) NSUInteger missCount;
+
+- (void) resetStatistics;
+
+@end
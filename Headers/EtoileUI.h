@@ -14,8 +14,16 @@
 
 #import <EtoileUI/EtoileUIProperties.h>
 #import <EtoileUI/ETItemValueTransformer.h>
+#import <EtoileUI/ETDisplayList.h>
 #import <EtoileUI/ETGeometry.h>
+#import <EtoileUI/ETImageLoader.h>
 #import <EtoileUI/ETLineFragment.h>
+#import <EtoileUI/ETRenderContext.h>
+#import <EtoileUI/ETRenderState.h>
+#import <EtoileUI/ETSelectionModel.h>
+#import <EtoileUI/ETSpatialIndex.h>
+#import <EtoileUI/ETTextMetricsCache.h>
+#import <EtoileUI/ETThumbnailCache.h>
 #import <EtoileUI/NSObject+EtoileUI.h>
 #import <EtoileUI/ETObjectValueFormatter.h>
 
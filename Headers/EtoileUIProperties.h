@@ -59,6 +59,7 @@ extern NSString * const kETSubtypeProperty; /** subtype property name */
 extern NSString * const kETTargetProperty; /** actionHandler property name */
 extern NSString * const kETTransformProperty; /** transform property name */
 extern NSString * const kETUTIProperty; /** UTI property name */
+extern NSString * const kETUsesSpatialIndexProperty; /** usesSpatialIndex property name */
 extern NSString * const kETValueProperty; /** value property name */
 extern NSString * const kETValueKeyProperty; /** valueKey property name */
 extern NSString * const kETViewProperty; /** view property name */
@@ -295,13 +295,13 @@ related NSBrowser methods are called. */
 	NSAssert(item != nil, @"Parent item must never be nil in -browser:numberOfRowsInColumn:");
 	NSAssert([item isGroup], @"Parent item must always be of ETLayoutItemGroup class kind");
 
-	NSInteger nbOfItems = [[item arrangedItems] count];
+	NSInteger nbOfItems = [item numberOfArrangedItems];
 	BOOL isFirstAccess = (0 == nbOfItems);
 
 	if (isFirstAccess)
 	{
 		[item reloadIfNeeded];
-		nbOfItems = [[item arrangedItems] count];	
+		nbOfItems = [item numberOfArrangedItems];	
 	}
 	
 	ETDebugLog(@"Returns %d as number of items in browser view %@", nbOfItems, sender);
@@ -330,7 +330,7 @@ related NSBrowser methods are called. */
 	NSAssert(item != nil, @"Parent item must never be nil in -browser:numberOfRowsInColumn:");
 	NSAssert([item isGroup], @"Parent item must always be of ETLayoutItemGroup class kind");
 
-	ETLayoutItem *childItem = [item arrangedItems][row];
+	ETLayoutItem *childItem = [item arrangedItemAtIndex: row];
 	[cell setRepresentedObject: childItem];
 	ETDebugLog(@"Set represented object %@ of cell %@", [cell representedObject], cell);
 
@@ -77,7 +77,17 @@ In the rare case where more control is required, you might want to reimplement
 	BOOL _usesAlignmentHint;
 	ETLayoutItem *_separatorTemplateItem;
 	CGFloat _separatorItemEndMargin;
+	NSMutableArray *_separatorItemPool;
 	BOOL _computesItemRectFromBoundingBox;
+	NSArray *_layoutModel;
+	BOOL _virtualizesItems;
+	CGFloat _virtualizationMargin;
+	/* Inputs and results of the last layout computation */
+	NSData *_layoutFingerprint;
+	NSArray *_fingerprintedItems;
+	NSArray *_computedItems;
+	NSData *_computedItemOrigins;
+	NSSize _computedLayoutSize;
 }
 
 /** @taskunit Alignment and Margins */
@@ -106,6 +116,19 @@ In the rare case where more control is required, you might want to reimplement
                  forContentHeight: (CGFloat)contentHeight;
 - (NSSize) computeLocationsForFragments: (NSArray *)layoutModel;
 
+/** @taskunit Virtualization */
+
+@property (nonatomic) BOOL virtualizesItems;
+@property (nonatomic) CGFloat virtualizationMargin;
+@property (nonatomic, readonly) NSRect exposedRect;
+
+- (void) updateExposedItems;
+
+/** @taskunit Hit Test */
+
+- (ETLayoutItem *) itemAtLocation: (NSPoint)location;
+- (ETLayoutItem *) itemInFragments: (NSArray *)layoutModel atLocation: (NSPoint)location;
+
 /** @taskunit Flexible Items */
 
 - (BOOL) isFlexibleItem: (ETLayoutItem *)anItem;
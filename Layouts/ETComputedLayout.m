@@ -9,22 +9,68 @@
 #import <EtoileFoundation/Macros.h>
 #import <EtoileFoundation/ETCollection+HOM.h>
 #import "ETComputedLayout.h"
+#import "ETGeometry.h"
 #import "ETLayoutExecutor.h"
 #import "ETLayoutItem.h"
 #import "ETLayoutItemFactory.h"
 #import "ETLayoutItemGroup.h"
 #import "ETLineFragment.h"
+#import "ETScrollableAreaItem.h"
 #import "ETCompatibility.h"
 
 CGFloat ETAlignmentHintNone = FLT_MIN;
 
+#define DEFAULT_VIRTUALIZATION_MARGIN 256
+
+/* The layout computation inputs that begin a layout fingerprint */
+typedef struct
+{
+	NSSize layoutSize;
+	CGFloat itemScaleFactor;
+	CGFloat borderMargin;
+	CGFloat itemMargin;
+	CGFloat horizontalAlignmentGuidePosition;
+	NSUInteger horizontalAlignment;
+	NSUInteger itemCount;
+	BOOL isFlipped;
+} ETLayoutInputs;
+
+/* The item inputs that follow the layout inputs in a layout fingerprint */
+typedef struct
+{
+	uintptr_t item;
+	NSSize size;
+	BOOL isFlexible;
+} ETItemInputs;
+
+static inline NSRect ETRectForItem(ETLayoutItem *anItem, BOOL usesBoundingBox)
+{
+	if (usesBoundingBox)
+	{
+		return [anItem convertRectToParent: [anItem boundingBox]];
+	}
+	else
+	{
+		return [anItem frame];
+	}
+}
+
 
 @implementation ETComputedLayout
 
 /* Ugly hacks to shut down the compiler, so it doesn't complain that inherited 
    methods also declared by ETPositionaLayout aren't implemented */
 - (id <ETLayoutingContext>) layoutContext { return [super layoutContext]; }
-- (ETLayoutItem *) itemAtLocation: (NSPoint)location { return [super itemAtLocation: location]; }
+
+- (instancetype) initWithObjectGraphContext: (COObjectGraphContext *)aContext
+{
+	self = [super initWithObjectGraphContext: aContext];
+	if (self == nil)
+		return nil;
+
+	_virtualizationMargin = DEFAULT_VIRTUALIZATION_MARGIN;
+	return self;
+}
 
 /** <override-never /> 
 Returns YES. */
@@ -249,14 +295,7 @@ content coordinate space.
 The parent is the layout context. */
 - (NSRect) rectForItem: (ETLayoutItem *)anItem
 {
-	if (_computesItemRectFromBoundingBox)
-	{
-		return [anItem convertRectToParent: [anItem boundingBox]];
-	}
-	else
-	{
-		return [anItem frame];
-	}
+	return ETRectForItem(anItem, _computesItemRectFromBoundingBox);
 }
 
 /** Moves the item frame by the given delta. */
@@ -348,6 +387,176 @@ bounding box). */
 	return didResize;
 }
 
+- (void) tearDown
+{
+	[super tearDown];
+	_layoutModel = nil;
+	[self discardLayoutFingerprint];
+}
+
+/** Discards the fragments computed during the last layout update, so they 
+don't retain the removed item until the next layout update.
+
+Until then, -itemAtLocation: falls back on -[ETLayout itemAtLocation:]. */
+- (void) didRemoveItem: (ETLayoutItem *)anItem
+{
+	[super didRemoveItem: anItem];
+	_layoutModel = nil;
+}
+
+/* Layout Memoization */
+
+/* Fills the layout inputs that begin a layout fingerprint.
+
+The struct is zeroed first, so the padding doesn't alter the fingerprint. */
+- (void) getLayoutInputs: (ETLayoutInputs *)inputs itemCount: (NSUInteger)count
+{
+	memset(inputs, 0, sizeof(ETLayoutInputs));
+	inputs->layoutSize = [self layoutSize];
+	inputs->itemScaleFactor = [[self layoutContext] itemScaleFactor];
+	inputs->borderMargin = _borderMargin;
+	inputs->itemMargin = _itemMargin;
+	inputs->horizontalAlignmentGuidePosition = _horizontalAlignmentGuidePosition;
+	inputs->horizontalAlignment = _horizontalAlignment;
+	inputs->itemCount = count;
+	inputs->isFlipped = [[self layoutContext] isFlipped];
+}
+
+/* Fills the item inputs that follow the layout inputs in a layout fingerprint.
+
+The struct is zeroed first, so the padding doesn't alter the fingerprint. */
+- (void) getItemInputs: (ETItemInputs *)inputs forItem: (ETLayoutItem *)item
+{
+	memset(inputs, 0, sizeof(ETItemInputs));
+	inputs->item = (uintptr_t)(__bridge void *)item;
+	inputs->size = ETRectForItem(item, _computesItemRectFromBoundingBox).size;
+	inputs->isFlexible = [self isFlexibleItem: item];
+}
+
+/** Returns the data that identifies the inputs of the layout computation for 
+the given items.
+
+The fingerprint covers the item identities, sizes and flexibility (see 
+-isFlexibleItem:), the layout size, the margins, the horizontal alignment, the 
+item scale factor and the layout context flipping. The item sizes are read with 
+the frame or the bounding box, and not -rectForItem: which subclasses can 
+derive from a previous computation. */
+- (NSData *) fingerprintForItems: (NSArray *)items
+{
+	NSUInteger count = [items count];
+	NSMutableData *fingerprint =
+		[NSMutableData dataWithLength: sizeof(ETLayoutInputs) + count * sizeof(ETItemInputs)];
+	ETLayoutInputs *inputs = [fingerprint mutableBytes];
+	ETItemInputs *itemInputs = (ETItemInputs *)(inputs + 1);
+
+	[self getLayoutInputs: inputs itemCount: count];
+
+	for (NSUInteger i = 0; i < count; i++)
+	{
+		[self getItemInputs: &itemInputs[i] forItem: items[i]];
+	}
+	return fingerprint;
+}
+
+/* Returns whether the inputs of the layout computation for the given items 
+match the fingerprint recorded by the last layout computation.
+
+The inputs are compared with the recorded fingerprint while they are read, so 
+no fingerprint is allocated, and the comparison stops at the first change. */
+- (BOOL) matchesLayoutFingerprintForItems: (NSArray *)items
+{
+	NSUInteger count = [items count];
+
+	if ([_layoutFingerprint length] != sizeof(ETLayoutInputs) + count * sizeof(ETItemInputs))
+		return NO;
+
+	const ETLayoutInputs *recordedInputs = [_layoutFingerprint bytes];
+	const ETItemInputs *recordedItemInputs = (const ETItemInputs *)(recordedInputs + 1);
+	ETLayoutInputs inputs;
+
+	[self getLayoutInputs: &inputs itemCount: count];
+
+	if (memcmp(&inputs, recordedInputs, sizeof(ETLayoutInputs)) != 0)
+		return NO;
+
+	for (NSUInteger i = 0; i < count; i++)
+	{
+		ETItemInputs itemInputs;
+
+		[self getItemInputs: &itemInputs forItem: items[i]];
+
+		if (memcmp(&itemInputs, &recordedItemInputs[i], sizeof(ETItemInputs)) != 0)
+			return NO;
+	}
+	return YES;
+}
+
+/* Records the results of the layout computation whose inputs match the given 
+fingerprint.
+
+The fingerprinted items are retained, so their addresses recorded in the 
+fingerprint cannot be reused by new items. */
+- (void) recordLayoutFingerprint: (NSData *)fingerprint
+                        forItems: (NSArray *)items
+                   computedItems: (NSArray *)computedItems
+                      layoutSize: (NSSize)layoutSize
+{
+	NSMutableData *origins = [NSMutableData dataWithLength: [computedItems count] * sizeof(NSPoint)];
+	NSPoint *itemOrigins = [origins mutableBytes];
+	NSUInteger i = 0;
+
+	for (ETLayoutItem *item in computedItems)
+	{
+		itemOrigins[i++] = ETRectForItem(item, _computesItemRectFromBoundingBox).origin;
+	}
+
+	_layoutFingerprint = fingerprint;
+	_fingerprintedItems = [items copy];
+	_computedItems = computedItems;
+	_computedItemOrigins = origins;
+	_computedLayoutSize = layoutSize;
+}
+
+/* Forces the next layout update to run the layout computation. */
+- (void) discardLayoutFingerprint
+{
+	_layoutFingerprint = nil;
+	_fingerprintedItems = nil;
+	_computedItems = nil;
+	_computedItemOrigins = nil;
+}
+
+/* Restores the item origins from the last layout computation, in case some 
+items were moved in the meantime, and returns the last computed layout size. */
+- (NSSize) renderWithComputedItemOrigins
+{
+	const NSPoint *itemOrigins = [_computedItemOrigins bytes];
+	NSUInteger i = 0;
+
+	for (ETLayoutItem *item in _computedItems)
+	{
+		[self setOrigin: itemOrigins[i++] forItem: item];
+	}
+
+	[[self layoutContext] setExposedItems: [self exposableItemsForItems: _computedItems]];
+	return _computedLayoutSize;
+}
+
+/** Discards the inputs recorded for the last layout computation, in addition 
+to the superclass behavior.
+
+Any property change, except -layoutSize which is computed, can alter the item 
+origins that the next layout computation would return. */
+- (void) willChangeValueForProperty: (NSString *)key
+{
+	[super willChangeValueForProperty: key];
+
+	if ([key isEqualToString: @"layoutSize"])
+		return;
+
+	[self discardLayoutFingerprint];
+}
+
 - (ETLayoutItem *) itemForLayoutContext
 {
 	return ([(id)[self layoutContext] isLayoutItem] ? (id)[self layoutContext]: (id)[(id)[self layoutContext] layoutContext]);
@@ -380,7 +589,12 @@ If flexible separators are used, before -adjustSeparatorItemsForLayoutSize: we h
 </list>
 
 Finally once the layout is computed, this method set the layout item visibility 
-by calling -setExposedItems: on the layout context. */
+by calling -setExposedItems: on the layout context.
+
+When the items, their sizes, the layout size, the margins, the alignment and 
+the item scale factor are the same as in the last layout computation, the 
+computation is skipped and the item origins it computed are reused. The 
+separator items inserted by this computation are kept with their origins. */
 - (NSSize) renderWithItems: (NSArray *)items isNewContent: (BOOL)isNewContent
 {
 	//NSLog(@" === UPDATE LAYOUT - %@ === ", [[self itemForLayoutContext] identifier]);
@@ -391,6 +605,12 @@ by calling -setExposedItems: on the layout context. */
 	[self adjustHorizontalAlignmentGuidePositionForItems: items];
 	[self adjustWidthForItems: items];
 
+	if ([self matchesLayoutFingerprintForItems: items])
+		return [self renderWithComputedItemOrigins];
+
+	/* Read before the computation alters the item sizes and the layout size */
+	NSData *fingerprint = [self fingerprintForItems: items];
+
 	NSSize initialLayoutSize = [self layoutSize];
 	NSArray *spacedItems = [self insertSeparatorsBetweenItems: items];
 	NSArray *layoutModel = [self generateFragmentsForItems: spacedItems];
@@ -415,7 +635,15 @@ by calling -setExposedItems: on the layout context. */
 
 	[self adjustSeparatorItemsForLayoutSize: newLayoutSize];
 
-	[[self layoutContext] setExposedItems: usedItems];
+	/* Kept to answer -itemAtLocation: and -updateExposedItems without 
+	   recomputing the layout */
+	_layoutModel = layoutModel;
+	[[self layoutContext] setExposedItems: [self exposableItemsForItems: usedItems]];
+
+	[self recordLayoutFingerprint: fingerprint
+	                     forItems: items
+	                computedItems: usedItems
+	                   layoutSize: newLayoutSize];
 	return newLayoutSize;
 }
 
@@ -520,13 +748,367 @@ rectangle that encloses the items and include border and item margins. */
 	return NSZeroSize;
 }
 
+/* Virtualization */
+
+/** Returns whether only the items that intersect -exposedRect are exposed, 
+when the layout context is scrollable.
+
+By default, returns NO. */
+- (BOOL) virtualizesItems
+{
+	return _virtualizesItems;
+}
+
+/** Sets whether only the items that intersect -exposedRect are exposed, when 
+the layout context is scrollable, and triggers a layout update.
+
+Items scrolled out of the exposed rect are unexposed, their views are removed 
+from the view hierarchy until they are scrolled back into it. This makes 
+possible to present a huge number of items, since only the items that are 
+visible on screen (or almost) get their views attached.
+
+While the layout context is not decorated by a scrollable area item, every item 
+is exposed as usual.
+
+Unexposed items are not returned by -[ETLayoutItemGroup visibleItems], so an 
+item scrolled out of the exposed rect is ignored by -itemAtLocation: and tools. */
+- (void) setVirtualizesItems: (BOOL)virtualizing
+{
+	[self willChangeValueForProperty: @"virtualizesItems"];
+	_virtualizesItems = virtualizing;
+	[self renderAndInvalidateDisplay];
+	[self didChangeValueForProperty: @"virtualizesItems"];
+}
+
+/** Returns the distance by which -exposedRect extends beyond the visible 
+content rect on each side.
+
+By default, returns 256. */
+- (CGFloat) virtualizationMargin
+{
+	return _virtualizationMargin;
+}
+
+/** Sets the distance by which -exposedRect extends beyond the visible content 
+rect on each side, and triggers a layout update.
+
+A bigger margin means fewer exposed item changes while scrolling, but more 
+views attached at the same time. */
+- (void) setVirtualizationMargin: (CGFloat)aMargin
+{
+	[self willChangeValueForProperty: @"virtualizationMargin"];
+	_virtualizationMargin = aMargin;
+	[self renderAndInvalidateDisplay];
+	[self didChangeValueForProperty: @"virtualizationMargin"];
+}
+
+/** Returns the rect in the layout context content coordinate space, that an 
+item must intersect to be exposed.
+
+The exposed rect is the visible part of the scrollable area content, extended 
+by -virtualizationMargin on each side.
+
+When -virtualizesItems returns NO or the layout context is not scrollable, 
+returns ETNullRect. */
+- (NSRect) exposedRect
+{
+	if (_virtualizesItems == NO || [[self layoutContext] isScrollable] == NO)
+		return ETNullRect;
+
+	ETScrollableAreaItem *scrollableAreaItem = [[self itemForLayoutContext] scrollableAreaItem];
+
+	if (scrollableAreaItem == nil)
+		return ETNullRect;
+
+	return NSInsetRect([scrollableAreaItem visibleRect],
+		-_virtualizationMargin, -_virtualizationMargin);
+}
+
+/* Returns the given items filtered to keep only the items that intersect 
+-exposedRect, or all the items when there is no exposed rect. */
+- (NSArray *) exposableItemsForItems: (NSArray *)items
+{
+	NSRect exposedRect = [self exposedRect];
+
+	if (ETIsNullRect(exposedRect))
+		return items;
+
+	NSMutableArray *exposableItems = [NSMutableArray array];
+
+	for (ETLayoutItem *item in items)
+	{
+		if (NSIntersectsRect(exposedRect, [item frame]))
+		{
+			[exposableItems addObject: item];
+		}
+	}
+	return exposableItems;
+}
+
+/* Returns the first index in [0, count[ that passes the test, or count.
+
+The test must fail for all the indexes before the returned one, and pass for 
+all the indexes after it. */
+static NSUInteger ETFirstIndexPassingTest(NSUInteger count, BOOL (^test)(NSUInteger index))
+{
+	NSUInteger low = 0;
+	NSUInteger high = count;
+
+	while (low < high)
+	{
+		NSUInteger middle = low + (high - low) / 2;
+
+		if (test(middle))
+		{
+			high = middle;
+		}
+		else
+		{
+			low = middle + 1;
+		}
+	}
+	return low;
+}
+
+/* Returns the range of the elements whose interval along an axis intersects 
+[min, max].
+
+The elements must be sorted along the axis, either by increasing or decreasing 
+position, and must not overlap. */
+static NSRange ETRangeOfIntervalsIntersectingInterval(NSArray *elements, 
+	CGFloat min, CGFloat max, void (^getInterval)(id element, CGFloat *min, CGFloat *max))
+{
+	NSUInteger count = [elements count];
+
+	if (count == 0)
+		return NSMakeRange(0, 0);
+
+	CGFloat firstMin = 0, firstMax = 0, lastMin = 0, lastMax = 0;
+
+	getInterval([elements firstObject], &firstMin, &firstMax);
+	getInterval([elements lastObject], &lastMin, &lastMax);
+
+	BOOL isAscending = (firstMin <= lastMin);
+	NSUInteger first = ETFirstIndexPassingTest(count, ^ (NSUInteger index)
+	{
+		CGFloat elementMin = 0, elementMax = 0;
+
+		getInterval(elements[index], &elementMin, &elementMax);
+		return (isAscending ? elementMax >= min : elementMin <= max);
+	});
+	NSUInteger end = ETFirstIndexPassingTest(count, ^ (NSUInteger index)
+	{
+		CGFloat elementMin = 0, elementMax = 0;
+
+		getInterval(elements[index], &elementMin, &elementMax);
+		return (isAscending ? elementMin > max : elementMax < min);
+	});
+
+	return (end > first ? NSMakeRange(first, end - first) : NSMakeRange(first, 0));
+}
+
+/* Returns the items that lie in the given rect along both axes, by searching 
+the lines that intersect the rect, then the items inside these lines.
+
+See also -itemInFragments:atLocation:. */
+- (NSArray *) itemsInFragments: (NSArray *)layoutModel intersectingRect: (NSRect)aRect
+{
+	ETLineFragment *firstLine = [layoutModel firstObject];
+
+	if (firstLine == nil)
+		return [NSArray array];
+
+	BOOL isVertical = [firstLine isVerticallyOriented];
+	NSRange lineRange = ETRangeOfIntervalsIntersectingInterval(layoutModel,
+		(isVertical ? NSMinX(aRect) : NSMinY(aRect)),
+		(isVertical ? NSMaxX(aRect) : NSMaxY(aRect)),
+		^ (ETLineFragment *line, CGFloat *min, CGFloat *max)
+	{
+		*min = (isVertical ? [line origin].x : [line origin].y);
+		*max = *min + (isVertical ? [line width] : [line height]);
+	});
+	NSMutableArray *items = [NSMutableArray array];
+
+	for (ETLineFragment *line in [layoutModel subarrayWithRange: lineRange])
+	{
+		NSArray *lineItems = [line items];
+		NSRange itemRange = ETRangeOfIntervalsIntersectingInterval(lineItems,
+			(isVertical ? NSMinY(aRect) : NSMinX(aRect)),
+			(isVertical ? NSMaxY(aRect) : NSMaxX(aRect)),
+			^ (ETLayoutItem *item, CGFloat *min, CGFloat *max)
+		{
+			NSRect rect = [self rectForItem: item];
+
+			*min = (isVertical ? NSMinY(rect) : NSMinX(rect));
+			*max = (isVertical ? NSMaxY(rect) : NSMaxX(rect));
+		});
+
+		[items addObjectsFromArray: [lineItems subarrayWithRange: itemRange]];
+	}
+	return items;
+}
+
+/** Exposes the items that intersect -exposedRect and unexposes the other ones, 
+based on the item locations computed during the last layout update.
+
+The layout is not recomputed. The scrollable area item that decorates the 
+layout context calls this method each time the content is scrolled.
+
+The lines computed during the last layout update are sorted along the layout 
+axis, so only the lines and items around the exposed rect are visited, with a 
+binary search.
+
+Does nothing when -virtualizesItems returns NO. */
+- (void) updateExposedItems
+{
+	NSRect exposedRect = [self exposedRect];
+
+	if (_layoutModel == nil || ETIsNullRect(exposedRect))
+		return;
+
+	NSArray *candidateItems = [self itemsInFragments: _layoutModel intersectingRect: exposedRect];
+
+	[[self layoutContext] setExposedItems: [self exposableItemsForItems: candidateItems]];
+}
+
+/* Hit Test */
+
+/* Returns the index of the element whose interval along an axis contains the 
+given position, or NSNotFound.
+
+The elements must be sorted along the axis, either by increasing or decreasing 
+position, and must not overlap. */
+static NSUInteger ETIndexOfIntervalContainingPosition(NSArray *elements, 
+	CGFloat position, void (^getInterval)(id element, CGFloat *min, CGFloat *max))
+{
+	NSUInteger count = [elements count];
+
+	if (count == 0)
+		return NSNotFound;
+
+	CGFloat firstMin = 0, firstMax = 0, lastMin = 0, lastMax = 0;
+
+	getInterval([elements firstObject], &firstMin, &firstMax);
+	getInterval([elements lastObject], &lastMin, &lastMax);
+
+	BOOL isAscending = (firstMin <= lastMin);
+	NSInteger low = 0;
+	NSInteger high = count - 1;
+
+	while (low <= high)
+	{
+		NSInteger middle = low + (high - low) / 2;
+		CGFloat min = 0, max = 0;
+
+		getInterval(elements[middle], &min, &max);
+
+		if (position < min)
+		{
+			if (isAscending)
+			{
+				high = middle - 1;
+			}
+			else
+			{
+				low = middle + 1;
+			}
+		}
+		else if (position > max)
+		{
+			if (isAscending)
+			{
+				low = middle + 1;
+			}
+			else
+			{
+				high = middle - 1;
+			}
+		}
+		else
+		{
+			return middle;
+		}
+	}
+	return NSNotFound;
+}
+
+/** Returns the visible item located at the given point in the layout context 
+coordinate space, or nil when there is none.
+
+Based on the fragments computed during the last layout update, the item is 
+found with a binary search on the lines, then on the items inside the matching 
+line, instead of testing every visible item.
+
+If the receiver has not been rendered yet, falls back on 
+-[ETLayout itemAtLocation:]. */
+- (ETLayoutItem *) itemAtLocation: (NSPoint)location
+{
+	if (_layoutModel == nil)
+		return [super itemAtLocation: location];
+
+	ETLayoutItem *item = [self itemInFragments: _layoutModel atLocation: location];
+
+	/* Separators and items removed since the last layout update are not 
+	   visible in the layout context. */
+	if (item == nil || [item isVisible] == NO)
+		return nil;
+
+	return (NSPointInRect(location, [item frame]) ? item : nil);
+}
+
+/** <override-dummy />
+Returns the item that lies at the given point in the layout model, or nil when 
+the point falls into a margin.
+
+The layout model is expected to be an array of ETLineFragment sorted along the 
+axis that is perpendicular to the line orientation, as 
+-generateFragmentsForItems: returns it. A point is matched against the line and 
+item rects, the caller is responsible to check it is inside the item frame.
+
+You can override this method to compute the item directly from the point, when 
+the layout geometry is regular enough (e.g. grid). */
+- (ETLayoutItem *) itemInFragments: (NSArray *)layoutModel atLocation: (NSPoint)location
+{
+	ETLineFragment *firstLine = [layoutModel firstObject];
+
+	if (firstLine == nil)
+		return nil;
+
+	BOOL isVertical = [firstLine isVerticallyOriented];
+	NSUInteger lineIndex = ETIndexOfIntervalContainingPosition(layoutModel,
+		(isVertical ? location.x : location.y), ^ (ETLineFragment *line, CGFloat *min, CGFloat *max)
+	{
+		*min = (isVertical ? [line origin].x : [line origin].y);
+		*max = *min + (isVertical ? [line width] : [line height]);
+	});
+
+	if (lineIndex == NSNotFound)
+		return nil;
+
+	NSArray *lineItems = [layoutModel[lineIndex] items];
+	NSUInteger itemIndex = ETIndexOfIntervalContainingPosition(lineItems,
+		(isVertical ? location.y : location.x), ^ (ETLayoutItem *item, CGFloat *min, CGFloat *max)
+	{
+		NSRect rect = [self rectForItem: item];
+
+		*min = (isVertical ? NSMinY(rect) : NSMinX(rect));
+		*max = (isVertical ? NSMaxY(rect) : NSMaxX(rect));
+	});
+
+	return (itemIndex != NSNotFound ? lineItems[itemIndex] : nil);
+}
+
 /* Seperator support */
 
-/** Sets the separator item to be drawn between each layouted item. */
+/** Sets the separator item to be drawn between each layouted item.
+
+The separator items copied from the previous template item are discarded. */
 - (void) setSeparatorTemplateItem: (ETLayoutItem *)separator
 {
 	[self willChangeValueForProperty: @"separatorTemplateItem"];
 	_separatorTemplateItem = separator;
+	[self removePreviousSeparatorItems];
+	_separatorItemPool = nil;
 	[self renderAndInvalidateDisplay];
 	[self didChangeValueForProperty: @"separatorTemplateItem"];
 }
@@ -567,35 +1149,86 @@ When the separator is the space, the end margin has usually no visible effects.
 	[[self layerItem] removeAllItems];
 }
 
+/* Returns the given number of separator items, once inserted into the layer 
+item.
+
+The separator items already in the layer item are reused, then the ones 
+removed by the previous layout updates. -separatorTemplateItem is copied only 
+when no separator item remains to be reused. When the separator count doesn't 
+change, the layer item is left untouched. */
+- (NSArray *) separatorItemsWithCount: (NSUInteger)count
+{
+	ETLayoutItemGroup *layerItem = [self layerItem];
+	NSUInteger currentCount = [layerItem numberOfItems];
+
+	if (_separatorItemPool == nil)
+	{
+		_separatorItemPool = [NSMutableArray array];
+	}
+
+	if (currentCount > count)
+	{
+		NSArray *extraItems = [[layerItem items]
+			subarrayWithRange: NSMakeRange(count, currentCount - count)];
+
+		[_separatorItemPool addObjectsFromArray: extraItems];
+		[layerItem removeItems: extraItems];
+	}
+	else if (currentCount < count)
+	{
+		NSMutableArray *missingItems = [NSMutableArray arrayWithCapacity: count - currentCount];
+
+		while (currentCount + [missingItems count] < count)
+		{
+			ETLayoutItem *separatorItem = [_separatorItemPool lastObject];
+
+			if (separatorItem != nil)
+			{
+				[_separatorItemPool removeLastObject];
+			}
+			else
+			{
+				separatorItem = [[self separatorTemplateItem] copy];
+			}
+			[missingItems addObject: separatorItem];
+		}
+		[layerItem addItems: missingItems];
+	}
+
+	return [layerItem items];
+}
+
 /** Prepares and inserts separator item based on -separatorTemplateItem into the 
 layer item.
 
-Separator items previously inserted by this method are automatically removed the 
-next time you call it. */
+The separator items inserted by the previous call are reused, and -separatorTemplateItem 
+is copied only when more separators are needed. Each separator item is passed 
+to -prepareSeparatorItem: to reset its size. */
 - (NSArray *) insertSeparatorsBetweenItems: (NSArray *)items
 {
 	ETAssert([self layerItem] != nil);
 
-	[self removePreviousSeparatorItems];
-
 	if ([self separatorTemplateItem] == nil)
+	{
+		[self removePreviousSeparatorItems];
 		return items;
+	}
 
-	NSMutableArray *spacedItems = [NSMutableArray array];
-	ETLayoutItem *lastItem = [items lastObject];
+	NSUInteger count = [items count];
+	NSArray *separatorItems = [self separatorItemsWithCount: (count > 0 ? count - 1 : 0)];
+	NSMutableArray *spacedItems = [NSMutableArray arrayWithCapacity: count * 2];
 
-	for (ETLayoutItem *item in items)
+	for (NSUInteger i = 0; i < count; i++)
 	{
-		[spacedItems addObject: item];
+		[spacedItems addObject: items[i]];
 
-		if ([item isEqual: lastItem])
+		if (i == count - 1)
 			break;
 
-		ETLayoutItem *separatorItem = [[self separatorTemplateItem] copy];
+		ETLayoutItem *separatorItem = separatorItems[i];
 
 		[self prepareSeparatorItem: separatorItem];
 		[spacedItems addObject: separatorItem];
-		[[self layerItem] addItem: separatorItem];
 	}
 
 	return spacedItems;
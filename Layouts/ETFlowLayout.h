@@ -35,6 +35,14 @@ returns YES, otherwise the content height will match the proposed layout size
 	@private
 	ETSizeConstraintStyle _layoutConstraint;
 	BOOL _usesGrid;
+	NSSize _gridCellSize;
+	/* Previous line breaking result reused by the next layout update */
+	NSArray *_previousItems;
+	NSData *_previousItemWidths;
+	NSData *_previousLineStarts;
+	NSArray *_previousFragments;
+	CGFloat _previousMaxLineWidth;
+	CGFloat _previousItemMargin;
 }
 
 /** @taskunit Flow Constraining and Streching */
@@ -127,34 +127,221 @@ to the items, which are expected to be already broken into lines in layoutModel.
 	return layoutSize;
 }
 
-/** Breaks the items into lines and returns the resulting line array. */
+/** Returns either the rect returned by the superclass implementation, or this 
+rect resized to the grid cell size when -usesGrid is YES.
+
+In grid mode, the line fragments get the item lengths from this method, so 
+resizing the rect to the cell is what lays out the items in cells. */
+- (NSRect) rectForItem: (ETLayoutItem *)anItem
+{
+	NSRect rect = [super rectForItem: anItem];
+
+	if (_usesGrid)
+	{
+		rect.size = _gridCellSize;
+	}
+	return rect;
+}
+
+/* Returns the size of the biggest item, every item is laid out in a cell 
+with this size in grid mode. */
+- (NSSize) gridCellSizeForItems: (NSArray *)items
+{
+	NSSize cellSize = NSZeroSize;
+
+	for (ETLayoutItem *item in items)
+	{
+		NSRect rect = [super rectForItem: item];
+
+		cellSize.width = MAX(cellSize.width, rect.size.width);
+		cellSize.height = MAX(cellSize.height, rect.size.height);
+	}
+	return cellSize;
+}
+
+/* Returns the max width available to lay out items on a line. */
+- (CGFloat) maxLineWidth
+{
+	if ([self layoutSizeConstraintStyle] != ETSizeConstraintStyleHorizontal)
+		return FLT_MAX;
+
+	return [self layoutSize].width - ([self itemMargin] + [self borderMargin]) * 2;
+}
+
+/* Returns a line filled with the items that follow the given index, or nil 
+when the first item doesn't fit into a line.
+
+The subset of items passed to -layoutFragmentWithSubsetOfItems: grows until 
+the line rejects some items, this way filling a line is not proportional to 
+the number of remaining items. */
+- (ETLineFragment *) lineWithItems: (NSArray *)items startingAtIndex: (NSUInteger)start
+{
+	NSUInteger remainingCount = [items count] - start;
+	NSUInteger length = MIN(remainingCount, 64);
+
+	while (YES)
+	{
+		NSArray *subset = [items subarrayWithRange: NSMakeRange(start, length)];
+		ETLineFragment *line = [self layoutFragmentWithSubsetOfItems: subset];
+
+		if (line == nil || [[line items] count] < length || length == remainingCount)
+			return line;
+
+		length = MIN(remainingCount, length * 2);
+	}
+}
+
+/** Breaks the items into lines and returns the resulting line array.
+
+The previous line array is kept, so the next call can restart the line breaking 
+at the first line that contains an item inserted or resized in the meantime. The line breaking stops as soon as a new line starts on a 
+previous line boundary followed by unchanged items, the previous lines are 
+then reused up to the end.
+
+Changing the layout size, the item margin or the border margin, or removing an 
+item from the layout context results in breaking all the lines again. */
 - (NSArray *) generateFragmentsForItems: (NSArray *)items
 {
-	NSMutableArray *unlayoutedItems = [NSMutableArray arrayWithArray: items];
+	if (_usesGrid)
+	{
+		_gridCellSize = [self gridCellSizeForItems: items];
+	}
+
+	NSUInteger count = [items count];
+	NSMutableData *itemWidths = [NSMutableData dataWithLength: count * sizeof(CGFloat)];
+	CGFloat *widths = [itemWidths mutableBytes];
+
+	for (NSUInteger i = 0; i < count; i++)
+	{
+		widths[i] = [self rectForItem: items[i]].size.width;
+	}
+
+	CGFloat maxLineWidth = [self maxLineWidth];
+	CGFloat itemMargin = [self itemMargin];
+	BOOL reflows = (_previousFragments != nil
+		&& maxLineWidth == _previousMaxLineWidth && itemMargin == _previousItemMargin);
+	NSUInteger oldCount = [_previousItems count];
+	NSUInteger oldLineCount = [_previousFragments count];
+	const CGFloat *oldWidths = [_previousItemWidths bytes];
+	const NSUInteger *oldLineStarts = [_previousLineStarts bytes];
+	/* Number of unchanged items at the start and at the end */
+	NSUInteger prefixCount = 0;
+	NSUInteger suffixCount = 0;
+
+	if (reflows)
+	{
+		NSUInteger minCount = MIN(count, oldCount);
+
+		while (prefixCount < minCount
+		    && items[prefixCount] == _previousItems[prefixCount]
+		    && widths[prefixCount] == oldWidths[prefixCount])
+		{
+			prefixCount++;
+		}
+		while (suffixCount < minCount
+		    && items[count - suffixCount - 1] == _previousItems[oldCount - suffixCount - 1]
+		    && widths[count - suffixCount - 1] == oldWidths[oldCount - suffixCount - 1])
+		{
+			suffixCount++;
+		}
+	}
+
 	NSMutableArray *layoutModel = [NSMutableArray array];
+	NSMutableData *lineStarts = [NSMutableData data];
+	NSUInteger start = 0;
+	NSUInteger oldLine = 0;
 
-	while ([unlayoutedItems count] > 0)
+	/* A line depends on its items and on the item that starts the next line, 
+	   since this item could fit into it once resized. */
+	while (reflows && oldLine + 1 < oldLineCount && oldLineStarts[oldLine + 1] < prefixCount)
 	{
-		ETLineFragment *line = [self layoutFragmentWithSubsetOfItems: unlayoutedItems];
-		
-		if ([[line items] count] > 0)
+		ETLineFragment *line = _previousFragments[oldLine];
+
+		[line setSkipsFlexibleFragments: YES];
+		[layoutModel addObject: line];
+		[lineStarts appendBytes: &start length: sizeof(NSUInteger)];
+
+		start = oldLineStarts[++oldLine];
+	}
+
+	while (start < count)
+	{
+		if (reflows && start >= count - suffixCount)
 		{
-			[layoutModel addObject: line];    
-				
-			/* In unlayoutedItems, remove the items which have just been 
-			   layouted on the previous line. */
-			[unlayoutedItems removeObjectsInArray: [line items]];
+			NSUInteger oldStart = start + oldCount - count;
+
+			while (oldLine < oldLineCount && oldLineStarts[oldLine] < oldStart)
+			{
+				oldLine++;
+			}
+
+			/* The remaining lines are the same as the previous ones */
+			if (oldLine < oldLineCount && oldLineStarts[oldLine] == oldStart)
+			{
+				for (; oldLine < oldLineCount; oldLine++)
+				{
+					ETLineFragment *line = _previousFragments[oldLine];
+					NSUInteger lineStart = oldLineStarts[oldLine] + count - oldCount;
+
+					[line setSkipsFlexibleFragments: YES];
+					[layoutModel addObject: line];
+					[lineStarts appendBytes: &lineStart length: sizeof(NSUInteger)];
+				}
+				break;
+			}
 		}
-		else
+
+		ETLineFragment *line = [self lineWithItems: items startingAtIndex: start];
+
+		if (line == nil)
 		{
-			ETDebugLog(@"Unlayouted items: %@", unlayoutedItems);
+			ETDebugLog(@"Unlayouted items: %@",
+				[items subarrayWithRange: NSMakeRange(start, count - start)]);
 			break;
 		}
+
+		[layoutModel addObject: line];
+		[lineStarts appendBytes: &start length: sizeof(NSUInteger)];
+
+		start += [[line items] count];
 	}
 
+	_previousItems = [items copy];
+	_previousItemWidths = itemWidths;
+	_previousLineStarts = lineStarts;
+	_previousFragments = layoutModel;
+	_previousMaxLineWidth = maxLineWidth;
+	_previousItemMargin = itemMargin;
+
 	return layoutModel;
 }
 
+/* Discards the previous line breaking result, so the lines and items it 
+references are not retained until the next layout update. */
+- (void) discardPreviousFragments
+{
+	_previousItems = nil;
+	_previousItemWidths = nil;
+	_previousLineStarts = nil;
+	_previousFragments = nil;
+}
+
+- (void) tearDown
+{
+	[super tearDown];
+	[self discardPreviousFragments];
+}
+
+/** Discards the previous line breaking result, since it retains the removed 
+item.
+
+The next layout update breaks all the lines again. */
+- (void) didRemoveItem: (ETLayoutItem *)anItem
+{
+	[super didRemoveItem: anItem];
+	[self discardPreviousFragments];
+}
+
 /** Returns a line filled with items to layout.
 
 Fills the layout line by iterating over the items until the total width extends 
@@ -164,17 +351,9 @@ not every items have been inserted into it.
 When items is empty, returns an empty layout line. */
 - (ETLineFragment *) layoutFragmentWithSubsetOfItems: (NSArray *)items
 {
-	CGFloat layoutWidth = FLT_MAX;
-	CGFloat totalMargin = ([self itemMargin] + [self borderMargin]) * 2;
-
-	if ([self layoutSizeConstraintStyle] == ETSizeConstraintStyleHorizontal)
-	{
-		layoutWidth = [self layoutSize].width - totalMargin;
-	}
-
 	ETLineFragment *line = [ETLineFragment horizontalLineWithOwner: self 
 	                                                    itemMargin: [self itemMargin] 
-	                                                      maxWidth: layoutWidth];
+	                                                      maxWidth: [self maxLineWidth]];
 	NSArray *acceptedItems = [line fillWithItems: items];
 
 	if ([acceptedItems isEmpty])
@@ -224,13 +403,20 @@ Default value is ETSizeConstraintStyleHorizontal. */
 	return _layoutConstraint;
 }
 
-/** Not yet implemented */
+/** Returns whether the items are laid out in a grid whose cells all have the 
+size of the biggest item.
+
+By default, returns NO. */
 - (BOOL) usesGrid
 {
 	return _usesGrid;
 }
 
-/** Not yet implemented */
+/** Sets whether the items are laid out in a grid whose cells all have the size 
+of the biggest item, and triggers a layout update.
+
+Each item is positioned at its cell origin. In a grid, -itemAtLocation: 
+computes the item row and column directly from the location. */
 - (void) setUsesGrid: (BOOL)constraint
 {
 	[self willChangeValueForProperty: @"usesGrid"];
@@ -239,4 +425,49 @@ Default value is ETSizeConstraintStyleHorizontal. */
 	[self didChangeValueForProperty: @"usesGrid"];
 }
 
+/** Returns the item in the grid cell that contains the given location when 
+-usesGrid is YES, otherwise returns the superclass implementation result.
+
+In grid mode, the row is computed from the location, then the column from the 
+location relative to the row origin, without searching the lines. */
+- (ETLayoutItem *) itemInFragments: (NSArray *)layoutModel atLocation: (NSPoint)location
+{
+	if (_usesGrid == NO)
+		return [super itemInFragments: layoutModel atLocation: location];
+
+	ETLineFragment *firstLine = [layoutModel firstObject];
+	CGFloat itemMargin = [self itemMargin];
+	CGFloat cellWidth = _gridCellSize.width + itemMargin;
+	CGFloat cellHeight = _gridCellSize.height + itemMargin;
+
+	if (firstLine == nil || cellWidth <= 0 || cellHeight <= 0)
+		return nil;
+
+	NSPoint firstOrigin = [firstLine origin];
+	/* For a non-flipped layout context, lines are stacked downwards from the 
+	   top of the first line (its origin being the bottom left corner) */
+	CGFloat dy = ([[self layoutContext] isFlipped]
+		? location.y - firstOrigin.y : firstOrigin.y + _gridCellSize.height - location.y);
+
+	if (dy < 0)
+		return nil;
+
+	NSUInteger row = floor(dy / cellHeight);
+
+	if (row >= [layoutModel count])
+		return nil;
+
+	/* Each line can start at its own 'x' (e.g. when a subclass indents lines) */
+	ETLineFragment *line = layoutModel[row];
+	CGFloat dx = location.x - [line origin].x;
+
+	if (dx < 0)
+		return nil;
+
+	NSUInteger column = floor(dx / cellWidth);
+	NSArray *lineItems = [line items];
+
+	return (column < [lineItems count] ? lineItems[column] : nil);
+}
+
 @end
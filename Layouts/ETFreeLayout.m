@@ -122,6 +122,10 @@ unlike ETPositionalLayout.  */
 	   for the free layout. */
 	if (_areHandlesHidden)
 		return;
+	/* When the selection is changed in a single pass, the handles are 
+	   updated once in -selectionDidChangeInLayoutContext: */
+	if ([[self layoutContext] isChangingSelection])
+		return;
 
 	BOOL selected = [change[NSKeyValueChangeNewKey] boolValue];
 	
@@ -209,6 +213,68 @@ unlike ETPositionalLayout.  */
 	}
 }
 
+/** Adds and removes handles to match the selected items, without rebuilding 
+the handles that remain valid.
+
+Each handle addition or removal is done once, so selecting or deselecting many 
+items with -[ETLayoutItemGroup setSelectionIndexPaths:] doesn't mutate the 
+layer item for every item. */
+- (void) updateHandlesForSelectedItems
+{
+	NSMapTable *handleGroupsByItem = [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsObjectPointerPersonality
+	                                                       valueOptions: NSPointerFunctionsObjectPointerPersonality];
+	NSMutableArray *obsoleteHandleGroups = [NSMutableArray array];
+	NSMutableArray *newHandleGroups = [NSMutableArray array];
+
+	for (ETLayoutItem *utilityItem in [[self layerItem] items])
+	{
+		if ([utilityItem isKindOfClass: [ETHandleGroup class]] == NO)
+			continue;
+
+		ETLayoutItem *manipulatedItem = [(ETHandleGroup *)utilityItem manipulatedObject];
+
+		if ([manipulatedItem isSelected] && [manipulatedItem parentItem] == (id)[self layoutContext])
+		{
+			[handleGroupsByItem setObject: utilityItem forKey: manipulatedItem];
+		}
+		else
+		{
+			[obsoleteHandleGroups addObject: utilityItem];
+			[manipulatedItem setNeedsDisplay: YES];
+		}
+	}
+
+	for (ETLayoutItem *item in _observedItems)
+	{
+		if ([item isSelected] == NO || [handleGroupsByItem objectForKey: item] != nil)
+			continue;
+
+		[newHandleGroups addObject: [[ETResizeRectangle alloc]
+			initWithManipulatedObject: item objectGraphContext: [[self layerItem] objectGraphContext]]];
+		[item setNeedsDisplay: YES];
+	}
+
+	if ([obsoleteHandleGroups isEmpty] == NO)
+	{
+		[[self layerItem] removeItems: obsoleteHandleGroups];
+	}
+	if ([newHandleGroups isEmpty] == NO)
+	{
+		[[self layerItem] addItems: newHandleGroups];
+	}
+}
+
+/** Updates the handles once the selection has been changed in a single pass.
+
+See -updateHandlesForSelectedItems. */
+- (void) selectionDidChangeInLayoutContext: (id <ETItemSelection>)aSelection
+{
+	if (_areHandlesHidden)
+		return;
+
+	[self updateHandlesForSelectedItems];
+}
+
 - (ETLayoutItemGroup *) handleGroupForItem: (ETLayoutItem *)aManipulatedItem
 {
 	for (ETLayoutItem *item in [self layerItem])
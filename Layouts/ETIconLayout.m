@@ -16,6 +16,7 @@
 #import "ETLayoutItem+Private.h"
 #import "ETLayoutItemFactory.h"
 #import "ETLayoutItemGroup.h"
+#import "ETTextMetricsCache.h"
 #import "EtoileUIProperties.h"
 // FIXME: Add -sizeWithAttributes: or similar to the AppKit graphics backend
 #import "ETWidgetBackend.h"
@@ -309,7 +310,8 @@ the given indicator rect. */
 	if (NSPointInRect(aPoint, labelRect) == NO)
 		return;								
 
-	NSSize labelSize = [label sizeWithAttributes: [iconStyle labelAttributes]];
+	NSSize labelSize = [[ETTextMetricsCache sharedInstance] sizeOfString: label
+	                                                       withAttributes: [iconStyle labelAttributes]];
 	CGFloat lineHeight = labelSize.height;
 	BOOL nbOfLines = 1;
 
@@ -42,6 +42,12 @@ ETLayout. */
 @property (nonatomic, readonly) NSArray *items;
 /** See -[ETLayoutItemGroup arrangedItems]. */
 @property (nonatomic, readonly) NSArray *arrangedItems;
+/** See -[ETLayoutItemGroup numberOfArrangedItems]. */
+@property (nonatomic, readonly) NSUInteger numberOfArrangedItems;
+/** See -[ETLayoutItemGroup arrangedItemAtIndex:]. */
+- (ETLayoutItem *) arrangedItemAtIndex: (NSUInteger)index;
+/** See -[ETLayoutItemGroup indexOfArrangedItem:]. */
+- (NSUInteger) indexOfArrangedItem: (ETLayoutItem *)anItem;
 /** See -[ETLayoutItem size]. */
 @property (nonatomic, readonly) NSSize size;
 /** See -[ETLayoutItemGroup setLayoutView:]. */
@@ -281,11 +287,17 @@ For a copy, -attachedTool is copied. */
 
 - (void) selectionDidChangeInLayoutContext: (id <ETItemSelection>)aSelection;
 
+/** @taskunit Content Changes */
+
+- (void) contentDidChangeInDescendantItem: (ETLayoutItemGroup *)anItem;
+- (void) didRemoveItem: (ETLayoutItem *)anItem;
+
 /** @taskunit Item Geometry and Display */
 
 - (ETLayoutItem *) itemAtLocation: (NSPoint)location;
 - (NSRect) displayRectOfItem: (ETLayoutItem *)item;
 - (void) setNeedsDisplayForItem: (ETLayoutItem *)item;
+- (void) item: (ETLayoutItem *)anItem didChangeValueForProperty: (NSString *)key;
 
 /** @taskunit Item State Indicators */
 
@@ -17,6 +17,7 @@
 #import "ETGeometry.h"
 #import "ETTool.h"
 #import "ETLayoutExecutor.h"
+#import "ETLayoutTracer.h"
 #import "ETLayoutItem+Private.h"
 #import "ETLayoutItemFactory.h"
 #import "ETLayoutItemGroup.h"
@@ -589,8 +590,11 @@ To explictly update the layout, just uses -[ETLayoutItemGroup updateLayout]. */
 	if ([self canRender] == NO)
 		return;
 
+	NSTimeInterval startTime = (ETLayoutTracingEnabled ? [[ETLayoutTracer sharedInstance] currentTime] : 0);
+
 	_isRendering = YES;
-	[self setLayoutSize: [self renderWithItems: [[self layoutContext] arrangedItems]
+	NSArray *arrangedItems = [[self layoutContext] arrangedItems];
+	[self setLayoutSize: [self renderWithItems: arrangedItems
 	                              isNewContent: isNewContent]];
 
 	/* Adjust layout context size (e.g. when it is embedded in a scroll view) */
@@ -603,6 +607,18 @@ To explictly update the layout, just uses -[ETLayoutItemGroup updateLayout]. */
 			NSStringFromSize([[self layoutContext] visibleContentSize]));
 	}
 	_isRendering = NO;
+
+	if (ETLayoutTracingEnabled)
+	{
+		ETLayoutTracer *tracer = [ETLayoutTracer sharedInstance];
+
+		[tracer recordEventWithName: NSStringFromClass([self class])
+		                   category: @"render"
+		                  startTime: startTime
+		                  arguments: @{ @"layoutContext": [tracer traceNameForObject: [self layoutContext]],
+		                                @"itemCount": @([arrangedItems count]),
+		                                @"isNewContent": @(isNewContent) }];
+	}
 }
 
 - (NSSize) proposedLayoutSize
@@ -908,6 +924,38 @@ For a concrete use case, see -[ETWidgetLayout isChangingSelection] . */
 	return NO;
 }
 
+/* Content Changes */
+
+/** <override-dummy />
+Tells the receiver the children of a descendant item have been inserted or 
+removed, when the receiver is an opaque layout that presents the descendant 
+item content.
+
+The layout context is marked as having new content, and the receiver will be 
+updated with -renderWithItems:isNewContent: once the descendant changes have 
+been reported. 
+
+Can be overriden to update only the descendant item presentation. For example, 
+ETOutlineLayout reloads the changed descendant items rather than all the rows.
+
+See also -[ETLayoutItemGroup(ETMutationHandler) insertedItemIndexes]. */
+- (void) contentDidChangeInDescendantItem: (ETLayoutItemGroup *)anItem
+{
+
+}
+
+/** <override-dummy />
+Tells the receiver the given item has been removed from the layout context, or 
+from a descendant item when the receiver is the opaque layout that presented it.
+
+You can override this method to discard any item or item value cached by the 
+layout. For example, ETTableLayout overrides this method to release the cell 
+values cached for the removed item and its descendants. */
+- (void) didRemoveItem: (ETLayoutItem *)anItem
+{
+
+}
+
 /* Item Geometry and Display */
 
 /** <override-dummy />
@@ -976,6 +1024,25 @@ the row associated with the given item. */
 	[[[self ifResponds] layoutView] setNeedsDisplayInRect: [self displayRectOfItem: anItem]];
 }
 
+/** <override-dummy />
+Tells the receiver a property value changed on the given item, when the 
+receiver is the opaque layout that presents it.
+
+You can override this method to discard any item value cached by the layout. 
+For example, ETTableLayout overrides this method to discard the cell values 
+cached for the given item.
+
+Represented object changes are reported too, but only when the item observes 
+its represented object, which requires the represented object to declare the 
+changed property in -observableKeyPaths. For other represented objects, the 
+changes must be reported with -setNeedsDisplayForItem:.
+
+See -[ETLayoutItem didChangeValueForProperty:]. */
+- (void) item: (ETLayoutItem *)anItem didChangeValueForProperty: (NSString *)key
+{
+
+}
+
 /* Item State Indicators */
 
 /** <override-never />
@@ -18,6 +18,7 @@
 {
 	@private
 	NSMutableSet *_scheduledItems;
+	NSMapTable *_dirtyReasons;
 }
 
 /** @taskunit Singleton Access */
@@ -15,6 +15,7 @@
 #import "ETLayoutItemGroup.h"
 #import "ETLayoutItemGroup+Mutation.h"
 #import "ETLayout.h"
+#import "ETLayoutTracer.h"
 #import "ETPositionalLayout.h"
 #import "ETCompatibility.h"
 
@@ -43,6 +44,7 @@ Initializes and returns a new layout executor. */
 {
 	SUPERINIT;
 	_scheduledItems = [[NSMutableSet alloc] init];
+	_dirtyReasons = [NSMapTable strongToStrongObjectsMapTable];
 	return self;
 }
 
@@ -95,40 +97,60 @@ the control returns to the run loop. */
 	return ([anItem usesFlexibleLayoutFrame] || [[[anItem parentItem] layout] isLayoutExecutionItemDependent]);
 }
 
-/** Inserts the item in the queue, in a way that ensures flexible items have 
-their layout updated before their parent item if the latter is flexible.
+/** Returns the number of ancestors above the given item.
 
-A flexible item is a item which returns YES to -isFlexibleItem:. */
-- (void) insertItem: (ETLayoutItemGroup *)anItem 
-inFlexibleItemQueue: (NSMutableArray *)flexibleItemQueue
+Depths computed previously are looked up in itemDepths, so computing the depth 
+of an item whose parent has already been visited costs O(1). */
+- (NSUInteger) depthOfItem: (ETLayoutItemGroup *)anItem 
+                itemDepths: (NSMapTable *)itemDepths
 {
-	[flexibleItemQueue removeObject: anItem];
+	if (anItem == nil)
+		return 0;
 
-	int nbOfQueuedItems = [flexibleItemQueue count];
+	NSNumber *cachedDepth = [itemDepths objectForKey: anItem];
 
-	for (int i = 0; i < nbOfQueuedItems; i++)
-	{
-		ETLayoutItemGroup *queuedItem = flexibleItemQueue[i];
-		/* The item to insert is a valid predecessor of the queued item.
+	if (cachedDepth != nil)
+		return [cachedDepth unsignedIntegerValue];
 
-		   Note: [[queuedItem parentItem] isEqual: anItem] would mean anItem 
-		   is the queued item successor, because the queued item is its child. */
-		BOOL isQueuedItemPredecessor = [queuedItem isEqual: [anItem parentItem]];
+	ETLayoutItemGroup *parentItem = [anItem parentItem];
+	NSUInteger depth = (parentItem != nil ? 
+		[self depthOfItem: parentItem itemDepths: itemDepths] + 1 : 0);
 
-		if (isQueuedItemPredecessor)
-		{
-			// NOTE: queuedItem is moved to i + 1
-			[flexibleItemQueue insertObject: anItem atIndex: i];
-			break;
-		}
-	}
-	
-	BOOL wasInserted = ([flexibleItemQueue count] > nbOfQueuedItems);
+	[itemDepths setObject: @(depth) forKey: anItem];
+	return depth;
+}
+
+/** Inserts the item in the bucket matching its depth in the item tree.
+
+Each bucket is an ordered set, so inserting an item already queued does 
+nothing, and the items at the same depth keep the order in which they were 
+marked as dirty. Since a flexible item is always deeper than its parent, 
+processing the buckets in reverse order ensures flexible items have their 
+layout updated before their parent item if the latter is flexible.
 
-	if (wasInserted == NO)
+A flexible item is a item which returns YES to -isFlexibleItem:. */
+- (void) insertItem: (ETLayoutItemGroup *)anItem 
+inFlexibleItemBuckets: (NSMutableArray *)flexibleItemBuckets
+         itemDepths: (NSMapTable *)itemDepths
+{
+	NSUInteger depth = [self depthOfItem: anItem itemDepths: itemDepths];
+
+	while ([flexibleItemBuckets count] <= depth)
 	{
-		[flexibleItemQueue addObject: anItem];
+		[flexibleItemBuckets addObject: [NSMutableOrderedSet orderedSet]];
 	}
+	[flexibleItemBuckets[depth] addObject: anItem];
+}
+
+/* Records why the item gets a layout update, when the layout passes are traced.
+
+The first reason recorded for an item is kept. */
+- (void) recordDirtyReason: (NSString *)aReason forItem: (ETLayoutItemGroup *)anItem
+{
+	if (ETLayoutTracingEnabled == NO || [_dirtyReasons objectForKey: anItem] != nil)
+		return;
+
+	[_dirtyReasons setObject: aReason forKey: anItem];
 }
 
 /** Schedules a parent item to have its layout updated.
@@ -136,34 +158,23 @@ inFlexibleItemQueue: (NSMutableArray *)flexibleItemQueue
 If the item hasn't been processed as a dirty item (not in the dirty items or not 
 checked by the iteration in -executeWithDirtyItems: yet), then it is marked as 
 dirty.<br />
-Otherwise the item might have to be moved to a new position in the flexible item 
-queue (if it uses a layout based frame), to ensure its will receive its layout 
-update once all its children have receive their own.   */
+Otherwise there is nothing to do. If the parent item uses a layout based frame, 
+it has already been put in the flexible item bucket matching its depth, which 
+guarantees it will receive its layout update once all its children have received 
+their own. */
 - (void) scheduleParentItem: (ETLayoutItemGroup *)parentItem 
                   processed: (BOOL)hasBeenProcessed
-        inFlexibleItemQueue: (NSMutableArray *)flexibleItemQueue
-                 dirtyItems: (NSMutableSet *)dirtyItems
+                 dirtyItems: (NSMutableOrderedSet *)dirtyItems
 {
-	if (parentItem == nil)
+	if (parentItem == nil || hasBeenProcessed)
 		return;
 
-	/* If the parent item has already been processed as a dirty item */
-	if (hasBeenProcessed)
-	{
-		// Same as [flexibleFrameItems containsObject: parentItem]
-		if ([self isFlexibleItem: parentItem] == NO)
-			return;
-
-		[self insertItem: parentItem inFlexibleItemQueue: flexibleItemQueue];
-	}
-	else
-	{
-		// If parent item uses a layout based frame, it must come after its child 
-		// in the flexibleFrameItems array because there is a dependency on  its 
-		// child frame to compute its own.
-		// We can ensure that by adding it the dirty items not yet processed.
-		[dirtyItems addObject: parentItem];
-	}
+	// If parent item uses a layout based frame, it must come after its child 
+	// in the flexible item queue because there is a dependency on its 
+	// child frame to compute its own.
+	// We can ensure that by adding it the dirty items not yet processed.
+	[dirtyItems addObject: parentItem];
+	[self recordDirtyReason: @"childFrameChanged" forItem: parentItem];
 }
 
 /** Marks the opaque item as having new content to get hierarchical widget 
@@ -174,42 +185,68 @@ layouts such as ETOutlineLayout calls -reloadData.
 We let the descendant item marked as having new content, although most widget 
 layouts won't use that. Future layout updates involving non-opaque layouts on 
 this item will reset hasNewContent (the layout update extra work due to 
-hasNewContent is going to be minimal). */
+hasNewContent is going to be minimal). 
+
+The opaque layout is told about the descendant item whose content changed, so 
+it can limit the update to this item rows (see 
+-[ETLayout contentDidChangeInDescendantItem:]). */
 - (void)updateHasNewContentForOpaqueItem: (ETLayoutItemGroup *)opaqueItem
                           descendantItem: (ETLayoutItemGroup *)item
 {
+	if ([item hasNewContent])
+	{
+		[[opaqueItem layout] contentDidChangeInDescendantItem: item];
+	}
 	[opaqueItem setHasNewContent: ([opaqueItem hasNewContent] || [item hasNewContent])];
 }
 
-/** Reorders the dirty items and marks additional items as dirty to respect the 
-layout update constraints, then tells the reordered items to update their layout. */
-- (void) executeWithDirtyItems: (NSSet *)scheduledItems
+/** Marks additional items as dirty to respect the layout update constraints, 
+then returns the flexible items ordered by decreasing depth in the item tree.
+
+The dirty items are processed in the order they are marked as dirty, so the 
+returned queue only depends on the scheduled items enumeration order.
+
+The non flexible items are collected into nonFlexibleItems, their layout 
+updates can be executed in any order once the flexible items are updated. */
+- (NSArray *) flexibleItemQueueForDirtyItems: (NSSet *)scheduledItems
+                            nonFlexibleItems: (NSMutableSet *)nonFlexibleItems
 {
-	NSMutableSet *dirtyItems = [NSMutableSet setWithSet: scheduledItems];
-	NSMutableSet *nonFlexibleItems = [NSMutableSet set];
-	NSMutableArray *flexibleItemQueue = [NSMutableArray array];
+	/* Processed items are kept, so an item marked as dirty again is ignored */
+	NSMutableOrderedSet *dirtyItems = [NSMutableOrderedSet orderedSetWithSet: scheduledItems];
+	NSMutableArray *flexibleItemBuckets = [NSMutableArray array];
+	NSMapTable *itemDepths = [NSMapTable strongToStrongObjectsMapTable];
 	NSMutableSet *processedItems = [NSMutableSet set];
 
-	while ([dirtyItems count] > 0)
+	if (ETLayoutTracingEnabled)
 	{
-		ETLayoutItemGroup *item = [dirtyItems anyObject];
+		for (ETLayoutItemGroup *item in scheduledItems)
+		{
+			[self recordDirtyReason: @"scheduled" forItem: item];
+		}
+	}
+
+	for (NSUInteger i = 0; i < [dirtyItems count]; i++)
+	{
+		ETLayoutItemGroup *item = dirtyItems[i];
 		ETLayoutItemGroup *opaqueItem = [item ancestorItemForOpaqueLayout];
 		BOOL hasOpaqueAncestorItem = (opaqueItem != item && opaqueItem != nil);
 
 		if (hasOpaqueAncestorItem)
 		{
 			[dirtyItems addObject: opaqueItem];
+			[self recordDirtyReason: @"descendantChanged" forItem: opaqueItem];
 			[self updateHasNewContentForOpaqueItem: opaqueItem descendantItem: item];
 		}
 		else if ([self isFlexibleItem: item])
 		{
-			[self insertItem: item inFlexibleItemQueue: flexibleItemQueue];
+			[self insertItem: item 
+			inFlexibleItemBuckets: flexibleItemBuckets 
+			           itemDepths: itemDepths];
 
 			/* When a dirty item uses a layout based frame, its parent 
 			   needs a layout update, in other words to be marked as dirty. */
 			[self scheduleParentItem: [item parentItem]
 			               processed: [processedItems containsObject: [item parentItem]]
-			     inFlexibleItemQueue: flexibleItemQueue
 			              dirtyItems: dirtyItems];
 		}
 		else
@@ -217,16 +254,90 @@ layout update constraints, then tells the reordered items to update their layout
 			[nonFlexibleItems addObject: item];
 		}
 
-		[dirtyItems removeObject: item];
 		[processedItems addObject: item];
 	}
 
+	NSMutableArray *flexibleItemQueue = [NSMutableArray array];
+
+	for (NSOrderedSet *bucket in [flexibleItemBuckets reverseObjectEnumerator])
+	{
+		[flexibleItemQueue addObjectsFromArray: [bucket array]];
+	}
+	return flexibleItemQueue;
+}
+
+/** Reorders the dirty items and marks additional items as dirty to respect the 
+layout update constraints, then tells the reordered items to update their layout.
+
+Flexible items are updated first, deepest items first, then the non flexible 
+items are updated.
+
+See -flexibleItemQueueForDirtyItems:nonFlexibleItems:. */
+- (void) executeWithDirtyItems: (NSSet *)scheduledItems
+{
+	if (ETLayoutTracingEnabled)
+	{
+		[self executeAndTraceWithDirtyItems: scheduledItems];
+		return;
+	}
+
+	NSMutableSet *nonFlexibleItems = [NSMutableSet set];
+	NSArray *flexibleItemQueue = [self flexibleItemQueueForDirtyItems: scheduledItems
+	                                                 nonFlexibleItems: nonFlexibleItems];
+
 	//ETLog(@"UPDATE LAYOUT -- Flexible items %i -- Non flexible items %i", 
 	//	[flexibleItemQueue count], [nonFlexibleItems count]);
 	[[flexibleItemQueue mappedCollection] updateLayoutRecursively: NO];
 	[[nonFlexibleItems mappedCollection] updateLayoutRecursively: NO];
 }
 
+/* Updates the layout of the given items, and records an event for each one in 
+the layout tracer. */
+- (void) updateAndTraceLayoutOfItems: (id <NSFastEnumeration>)items
+{
+	ETLayoutTracer *tracer = [ETLayoutTracer sharedInstance];
+
+	for (ETLayoutItemGroup *item in items)
+	{
+		NSString *reason = [_dirtyReasons objectForKey: item];
+		BOOL hadNewContent = [item hasNewContent];
+		NSTimeInterval startTime = [tracer currentTime];
+
+		[item updateLayoutRecursively: NO];
+
+		[tracer recordEventWithName: [tracer traceNameForObject: item]
+		                   category: @"layoutUpdate"
+		                  startTime: startTime
+		                  arguments: @{ @"reason": (reason != nil ? reason : @"unknown"),
+		                                @"hasNewContent": @(hadNewContent),
+		                                @"itemCount": @([item numberOfItems]) }];
+	}
+}
+
+/** Does the same than -executeWithDirtyItems:, but records the layout pass and 
+each item layout update in the layout tracer.
+
+See ETLayoutTracer. */
+- (void) executeAndTraceWithDirtyItems: (NSSet *)scheduledItems
+{
+	ETLayoutTracer *tracer = [ETLayoutTracer sharedInstance];
+	NSTimeInterval startTime = [tracer currentTime];
+	NSMutableSet *nonFlexibleItems = [NSMutableSet set];
+	NSArray *flexibleItemQueue = [self flexibleItemQueueForDirtyItems: scheduledItems
+	                                                 nonFlexibleItems: nonFlexibleItems];
+
+	[self updateAndTraceLayoutOfItems: flexibleItemQueue];
+	[self updateAndTraceLayoutOfItems: nonFlexibleItems];
+
+	[tracer recordEventWithName: @"ETLayoutExecutor pass"
+	                   category: @"layoutExecutor"
+	                  startTime: startTime
+	                  arguments: @{ @"scheduledItemCount": @([scheduledItems count]),
+	                                @"flexibleItemCount": @([flexibleItemQueue count]),
+	                                @"nonFlexibleItemCount": @([nonFlexibleItems count]) }];
+	[_dirtyReasons removeAllObjects];
+}
+
 /** Executes the layout updates previously scheduled.
 
 Additional layout updates that might be scheduled while running this method 
@@ -0,0 +1,68 @@
+/**
+	<abstract>Records layout passes to be inspected in a trace viewer.</abstract>
+
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <Foundation/Foundation.h>
+
+/** Whether the layout passes are recorded by the shared layout tracer.
+
+Checked before recording anything, so tracing costs a single branch when 
+disabled. Use -[ETLayoutTracer setEnabled:] to change it. */
+extern BOOL ETLayoutTracingEnabled;
+
+/** @abstract Records the time spent in layout passes
+
+When enabled, ETLayoutExecutor and ETLayout record an event for each 
+executor pass, each item group layout update and each layout rendering. The 
+layout update events report why the item group was updated, and the rendering 
+events report the item count and whether the content is new.
+
+The events can be exported in the Chrome trace event format, and opened in 
+chrome://tracing or Perfetto, where the nested events show which item group 
+layout caused a slow pass.
+
+ETLayoutTracer is not designed to be subclassed. */
+@interface ETLayoutTracer : NSObject
+{
+	@private
+	NSMutableArray *_events;
+	NSTimeInterval _startTime;
+}
+
+/** @taskunit Singleton Access */
+
++ (instancetype) sharedInstance;
+
+/** @taskunit Controlling Tracing */
+
+/** Whether the layout passes are recorded.
+
+By default, returns NO. */
+@property (nonatomic, getter=isEnabled) BOOL enabled;
+
+- (void) removeAllEvents;
+
+/** @taskunit Recording Events */
+
+- (NSTimeInterval) currentTime;
+- (NSString *) traceNameForObject: (id)anObject;
+- (void) recordEventWithName: (NSString *)aName
+                    category: (NSString *)aCategory
+                   startTime: (NSTimeInterval)startTime
+                   arguments: (NSDictionary *)arguments;
+
+/** @taskunit Exporting Events */
+
+/** The recorded events as Chrome trace event dictionaries. */
+@property (nonatomic, readonly) NSArray *events;
+
+- (NSData *) traceData;
+- (BOOL) writeTraceToFile: (NSString *)aPath error: (NSError **)anError;
+
+@end
@@ -0,0 +1,134 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <EtoileFoundation/Macros.h>
+#import "ETLayoutTracer.h"
+#import "ETCompatibility.h"
+
+BOOL ETLayoutTracingEnabled = NO;
+
+@implementation ETLayoutTracer
+
+static ETLayoutTracer *sharedInstance = nil;
+
++ (void) initialize
+{
+	if ([self isEqual: [ETLayoutTracer class]] == NO)
+		return;
+
+	sharedInstance = [[self alloc] init];
+}
+
+/** Returns the shared layout tracer. */
++ (instancetype) sharedInstance
+{
+	return sharedInstance;
+}
+
+/* <init />
+Initializes and returns a new disabled layout tracer. */
+- (instancetype) init
+{
+	SUPERINIT;
+	_events = [[NSMutableArray alloc] init];
+	_startTime = [NSDate timeIntervalSinceReferenceDate];
+	return self;
+}
+
+- (BOOL) isEnabled
+{
+	return ETLayoutTracingEnabled;
+}
+
+/** Enables or disables the layout tracing.
+
+The recorded events are kept when the tracing is disabled, see 
+-removeAllEvents. */
+- (void) setEnabled: (BOOL)enabled
+{
+	ETLayoutTracingEnabled = enabled;
+}
+
+/** Discards the recorded events and resets the trace clock. */
+- (void) removeAllEvents
+{
+	[_events removeAllObjects];
+	_startTime = [NSDate timeIntervalSinceReferenceDate];
+}
+
+#pragma mark Recording Events -
+
+/** Returns the time to be passed as the start time of an event, once it ends. */
+- (NSTimeInterval) currentTime
+{
+	return [NSDate timeIntervalSinceReferenceDate];
+}
+
+/** Returns a short name to identify the given layout item or layout context in 
+the trace, based on its class and its identifier or its address. */
+- (NSString *) traceNameForObject: (id)anObject
+{
+	NSString *identifier = ([anObject respondsToSelector: @selector(identifier)] ? [anObject identifier] : nil);
+
+	if (identifier != nil)
+	{
+		return [NSString stringWithFormat: @"%@ %@", NSStringFromClass([anObject class]), identifier];
+	}
+	return [NSString stringWithFormat: @"%@ %p", NSStringFromClass([anObject class]), anObject];
+}
+
+/** Records an event that began at the given start time and ends now.
+
+The arguments must be serializable as JSON, and are shown with the event in the 
+trace viewer.
+
+Does nothing when -isEnabled returns NO. */
+- (void) recordEventWithName: (NSString *)aName
+                    category: (NSString *)aCategory
+                   startTime: (NSTimeInterval)startTime
+                   arguments: (NSDictionary *)arguments
+{
+	if (ETLayoutTracingEnabled == NO)
+		return;
+
+	NSTimeInterval endTime = [self currentTime];
+
+	/* Complete event with timestamps in microseconds */
+	[_events addObject: @{ @"name": aName,
+	                       @"cat": aCategory,
+	                       @"ph": @"X",
+	                       @"ts": @((startTime - _startTime) * 1e6),
+	                       @"dur": @((endTime - startTime) * 1e6),
+	                       @"pid": @([[NSProcessInfo processInfo] processIdentifier]),
+	                       @"tid": @1,
+	                       @"args": (arguments != nil ? arguments : @{}) }];
+}
+
+#pragma mark Exporting Events -
+
+- (NSArray *) events
+{
+	return [_events copy];
+}
+
+/** Returns the recorded events as a Chrome trace event JSON document. */
+- (NSData *) traceData
+{
+	NSDictionary *trace = @{ @"traceEvents": _events, @"displayTimeUnit": @"ms" };
+	return [NSJSONSerialization dataWithJSONObject: trace options: 0 error: NULL];
+}
+
+/** Writes the recorded events as a Chrome trace event JSON file.
+
+Returns NO and reports the error when the file cannot be written. */
+- (BOOL) writeTraceToFile: (NSString *)aPath error: (NSError **)anError
+{
+	return [[self traceData] writeToFile: aPath options: NSDataWritingAtomic error: anError];
+}
+
+@end
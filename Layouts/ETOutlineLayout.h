@@ -18,7 +18,9 @@
 /** See [ETTableLayout] API to customize ETOutlineLayout look and behavior. */
 @interface ETOutlineLayout : ETTableLayout 
 {
-
+	@private
+	/* The descendant items to reload on the next layout update */
+	NSMutableSet *_changedDescendantItems;
 }
 
 @end
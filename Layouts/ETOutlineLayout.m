@@ -15,6 +15,7 @@
 #import "ETPickDropActionHandler.h"
 #import "ETEvent.h"
 #import "ETLayoutItemGroup.h"
+#import "ETLayoutItemGroup+Mutation.h"
 #import "ETPickboard.h"
 #import "ETPickDropCoordinator.h"
 #import "ETSelectTool.h"
@@ -138,6 +139,53 @@
 	[[self outlineView] selectRowIndexes: rowIndexes byExtendingSelection: NO];
 }
 
+- (void) contentDidChangeInDescendantItem: (ETLayoutItemGroup *)anItem
+{
+	if (_changedDescendantItems == nil)
+	{
+		_changedDescendantItems = [NSMutableSet set];
+	}
+	[_changedDescendantItems addObject: anItem];
+}
+
+/** Reloads the descendant items whose children were inserted or removed, and 
+returns YES.
+
+Returns NO when the layout context children were inserted or removed too, or 
+when the changes are unknown, -renderWithItems:isNewContent: then reloads all 
+the rows. */
+- (BOOL) updateRowsWithContentChanges
+{
+	NSSet *changedItems = _changedDescendantItems;
+	ETLayoutItemGroup *context = [self layoutContext];
+
+	_changedDescendantItems = nil;
+
+	if ([(id)context isLayoutItem] == NO)
+		return NO;
+
+	NSIndexSet *removedIndexes = [context removedItemIndexes];
+	NSIndexSet *insertedIndexes = [context insertedItemIndexes];
+	BOOL hasNewRootContent = (removedIndexes == nil || insertedIndexes == nil
+		|| [removedIndexes count] > 0 || [insertedIndexes count] > 0);
+
+	if (hasNewRootContent || [changedItems isEmpty])
+		return NO;
+
+	NSOutlineView *outlineView = [self outlineView];
+
+	for (ETLayoutItemGroup *item in changedItems)
+	{
+		/* Skip the items moved out of the layout context since the change */
+		if ([item ancestorItemForOpaqueLayout] != context)
+			continue;
+
+		[outlineView reloadItem: item reloadChildren: YES];
+	}
+
+	return YES;
+}
+
 - (NSArray *) selectedItems
 {
 	NSOutlineView *outlineView = [self outlineView];
@@ -193,7 +241,7 @@
 	
 	if (isRootItem)
 	{
-		nbOfItems = [[[self layoutContext] arrangedItems] count];
+		nbOfItems = [[self layoutContext] numberOfArrangedItems];
 
 		/* First time. Useful when the layout context is browsed or 
 		   inspected without having been loaded and displayed yet. 
@@ -202,18 +250,18 @@
 		if (nbOfItems == 0)
 		{
 			[(ETLayoutItemGroup *)[self layoutContext] reloadIfNeeded];
-			nbOfItems = [[[self layoutContext] arrangedItems] count];
+			nbOfItems = [[self layoutContext] numberOfArrangedItems];
 		}
 	}
 	else if ([item isGroup]) 
 	{
-		nbOfItems = [[item arrangedItems] count];
+		nbOfItems = [item numberOfArrangedItems];
 		
 		/* First time */
 		if (nbOfItems == 0)
 		{
 			[item reloadIfNeeded];
-			nbOfItems = [[item arrangedItems] count];
+			nbOfItems = [item numberOfArrangedItems];
 		}
 	}
 	
@@ -229,11 +277,11 @@
 	
 	if (isRootItem)
 	{
-		childItem = [[self layoutContext] arrangedItems][rowIndex];
+		childItem = [[self layoutContext] arrangedItemAtIndex: rowIndex];
 	}
 	else if ([item isGroup])
 	{
-		childItem = [(ETLayoutItemGroup *)item arrangedItems][rowIndex];
+		childItem = [(ETLayoutItemGroup *)item arrangedItemAtIndex: rowIndex];
 	}
 
 	//ETLog(@"Returns %@ child item in outline view %@", childItem, outlineView);
@@ -36,6 +36,8 @@ descriptor bound to the widget table column will be used (and eventually created
 	NSMutableArray *_currentSortDescriptors;
 	NSFont *_contentFont;
 	BOOL _sortable;
+	/* The cell values per item and property */
+	NSMapTable *_cachedValues;
 }
 
 /** @taskunit Item Property Display */
@@ -78,6 +80,9 @@ descriptor bound to the widget table column will be used (and eventually created
 - (void) setObjectValue: (id)value
          forTableColumn: (NSTableColumn *)column
                    item: (ETLayoutItem *)item;
+- (void) discardCachedValues;
+- (void) discardCachedValuesForItem: (ETLayoutItem *)anItem;
+- (BOOL) updateRowsWithContentChanges;
 - (void) trySortRecursively: (BOOL)recursively oldSortDescriptors: (NSArray *)oldDescriptors;
 
 @property (nonatomic, strong) NSEvent *backendDragEvent;
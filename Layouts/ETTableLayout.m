@@ -16,6 +16,7 @@
 #import "ETLayoutItem.h"
 #import "ETLayoutItem+AppKit.h"
 #import "ETLayoutItemGroup.h"
+#import "ETLayoutItemGroup+Mutation.h"
 #import "EtoileUIProperties.h"
 #import "ETEvent.h"
 #import "ETPickboard.h"
@@ -36,6 +37,8 @@
 @end
 
 #define DEFAULT_ROW_HEIGHT 16
+/* The minimum number of items whose cell values can be cached */
+#define MIN_CACHED_ITEM_COUNT 64
 
 @implementation ETTableLayout
 
@@ -92,6 +95,8 @@
 	   the ivar must be reset for each new layout view. */
 	_propertyColumns = [NSMutableDictionary dictionary];
 	_sortable = YES;
+	_cachedValues = [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+	                                      valueOptions: NSPointerFunctionsStrongMemory];
 
 	/* Retain initial columns to be able to restore exactly identical columns later */	
 	for (NSTableColumn *column in [tv tableColumns])
@@ -295,6 +300,7 @@ with the formatter, otherwise the outcome of the formatting is unknown. */
 	   NSString as its input value. */
 	[[column dataCell] setObjectValue: nil];
 	[[column dataCell] setFormatter: aFormatter];
+	[self discardCachedValues];
 	[self didChangeValueForProperty: @"propertyColumns"];
 	[self didChangeValueForProperty: @"layoutView"];
 }
@@ -332,6 +338,7 @@ more widget backend agnostic. */
 		// different for Cocoa).
 		[column setEditable: [cell isEditable]];
 	}
+	[self discardCachedValues];
 	[self didChangeValueForProperty: @"propertyColumns"];
 	[self didChangeValueForProperty: @"layoutView"];
 }
@@ -503,12 +510,66 @@ See [(ETColumnFragment)] protocol to customize the returned column. */
 		id source = [[[self layoutContext] ifResponds] source];
 		[self _updateDisplayedPropertiesFromSource: source];
 
-		[[self tableView] reloadData];
+		/* The values cached for removed items are discarded by -didRemoveItem: */
+		if ([self updateRowsWithContentChanges] == NO)
+		{
+			[self discardCachedValues];
+			[[self tableView] reloadData];
+		}
 		[[self tableView] setNeedsDisplay: YES]; // FIXME: -updateLayout redisplay should be enough
 	}
 	return [self layoutSize];
 }
 
+/** This method is only exposed to be used internally by EtoileUI.
+
+Removes and inserts the rows matching the children removed and inserted in the 
+layout context since the last layout update, and returns YES.
+
+Returns NO when the changes are unknown, for example after a reload or a sort, 
+or when the table view cannot insert and remove rows, 
+-renderWithItems:isNewContent: then reloads all the rows.
+
+See -[ETLayoutItemGroup(ETMutationHandler) insertedItemIndexes]. */
+- (BOOL) updateRowsWithContentChanges
+{
+	ETLayoutItemGroup *context = [self layoutContext];
+
+	if ([(id)context isLayoutItem] == NO)
+		return NO;
+
+	NSIndexSet *removedIndexes = [context removedItemIndexes];
+	NSIndexSet *insertedIndexes = [context insertedItemIndexes];
+
+	if (removedIndexes == nil || insertedIndexes == nil)
+		return NO;
+
+	NSTableView *tv = [self tableView];
+	NSInteger nbOfRows = [tv numberOfRows] - [removedIndexes count] + [insertedIndexes count];
+
+	/* The table view doesn't present the children as they were on the last 
+	   layout update (e.g. the layout view has just been set up) */
+	if (nbOfRows != [context numberOfArrangedItems])
+		return NO;
+
+	/* Row insertion and removal are not available on every AppKit version 
+	   (e.g. GNUstep) */
+	BOOL supportsRowUpdates = ([tv respondsToSelector: @selector(beginUpdates)]
+		&& [tv respondsToSelector: @selector(removeRowsAtIndexes:withAnimation:)]
+		&& [tv respondsToSelector: @selector(insertRowsAtIndexes:withAnimation:)]
+		&& [tv respondsToSelector: @selector(endUpdates)]);
+
+	if (supportsRowUpdates == NO)
+		return NO;
+
+	[tv beginUpdates];
+	[tv removeRowsAtIndexes: removedIndexes withAnimation: NSTableViewAnimationEffectNone];
+	[tv insertRowsAtIndexes: insertedIndexes withAnimation: NSTableViewAnimationEffectNone];
+	[tv endUpdates];
+
+	return YES;
+}
+
 - (void) resizeItems: (NSArray *)items toScaleFactor: (CGFloat)factor
 {
 	// NOTE: Always recompute row height from the original one to avoid really
@@ -527,20 +588,22 @@ See [(ETColumnFragment)] protocol to customize the returned column. */
 	int row = [[self tableView] rowAtPoint: location];
 	
 	if (-1 != row)
-		return [[self layoutContext] arrangedItems][row];
+		return [[self layoutContext] arrangedItemAtIndex: row];
 	
 	return nil;
 }
 
 - (NSRect) displayRectOfItem: (ETLayoutItem *)item
 {
-	int row = [[[self layoutContext] arrangedItems] indexOfObject: item];
+	int row = [[self layoutContext] indexOfArrangedItem: item];
 	return [[self tableView] rectOfRow: row];
 }
 
-/** Invalidates the row associated with the given item. */
+/** Invalidates the row associated with the given item, and discards the cell 
+values cached for this item. */
 - (void) setNeedsDisplayForItem: (ETLayoutItem *)anItem
 {
+	[self discardCachedValuesForItem: anItem];
 	[[self tableView] setNeedsDisplayInRect: [self displayRectOfItem: anItem]];
 }
 
@@ -561,13 +624,13 @@ See [(ETColumnFragment)] protocol to customize the returned column. */
 {
 	NSIndexSet *indexes = [[self tableView] selectedRowIndexes];
 	NSEnumerator *indexEnumerator = [indexes objectEnumerator];
-	NSArray *items = [[self layoutContext] arrangedItems];
+	id <ETLayoutingContext> context = [self layoutContext];
 	NSMutableArray *selectedItems = 
 		[NSMutableArray arrayWithCapacity: [indexes count]];
 	
 	FOREACHE(nil, index, NSNumber *, indexEnumerator)
 	{
-		[selectedItems addObject: items[[index intValue]]];
+		[selectedItems addObject: [context arrangedItemAtIndex: [index intValue]]];
 	}
 	
 	return selectedItems;
@@ -635,7 +698,7 @@ See [(ETColumnFragment)] protocol to customize the returned column. */
 
 - (ETLayoutItem *) itemAtRow: (int)rowIndex
 {
-	return [[self layoutContext] arrangedItems][rowIndex];
+	return [[self layoutContext] arrangedItemAtIndex: rowIndex];
 }
 
 - (ETLayoutItem *) editedItem
@@ -704,11 +767,11 @@ See [(ETColumnFragment)] protocol to customize the returned column. */
 
 - (NSInteger) numberOfRowsInTableView: (NSTableView *)tv
 {
-	NSArray *layoutItems = [[self layoutContext] arrangedItems];
+	NSUInteger nbOfItems = [[self layoutContext] numberOfArrangedItems];
 	
-	ETDebugLog(@"Returns %lu as number of items in table view %@", (unsigned long)[layoutItems count], [tv primitiveDescription]);
+	ETDebugLog(@"Returns %lu as number of items in table view %@", (unsigned long)nbOfItems, [tv primitiveDescription]);
 	
-	return [layoutItems count];
+	return nbOfItems;
 }
 
 - (NSString *) propertyForColumn: (NSTableColumn *)column
@@ -719,16 +782,117 @@ See [(ETColumnFragment)] protocol to customize the returned column. */
 	return (blankColumnIdentifier ? kETValueProperty : identifier);
 }
 
+/** Discards the cell values cached for the given item.
+
+See -discardCachedValues. */
+- (void) discardCachedValuesForItem: (ETLayoutItem *)anItem
+{
+	[_cachedValues removeObjectForKey: anItem];
+}
+
+/** Discards all the cell values cached by 
+-objectValueForTableColumn:row:item:. 
+
+The cached values are discarded each time the table view is reloaded or a 
+column data cell changes. Item values are discarded individually with 
+-setNeedsDisplayForItem: and -item:didChangeValueForProperty:. */
+- (void) discardCachedValues
+{
+	[_cachedValues removeAllObjects];
+}
+
+- (void) item: (ETLayoutItem *)anItem didChangeValueForProperty: (NSString *)key
+{
+	[self discardCachedValuesForItem: anItem];
+}
+
+/* Returns the maximum number of items whose cell values can be cached, this is 
+twice the number of visible rows, so scrolling back and forth doesn't discard 
+the values too often. */
+- (NSUInteger) maxCachedItemCount
+{
+	NSTableView *tv = [self tableView];
+	NSUInteger nbOfVisibleRows = [tv rowsInRect: [tv visibleRect]].length;
+
+	return MAX(MIN_CACHED_ITEM_COUNT, 2 * nbOfVisibleRows);
+}
+
+/* Returns whether a changed value is reported to -item:didChangeValueForProperty:.
+
+A represented object change is only reported when the property belongs to the 
+represented object -observableKeyPaths, see 
+-[ETLayout item:didChangeValueForProperty:]. */
+- (BOOL) canCacheValueForProperty: (NSString *)property item: (ETLayoutItem *)item
+{
+	id repObject = [item representedObject];
+
+	if (repObject == nil)
+		return YES;
+
+	return [[repObject observableKeyPaths] containsObject: property];
+}
+
+/* Returns whether the item is the given ancestor item or one of its descendants. */
+static inline BOOL ETIsItemOrDescendantOfItem(ETLayoutItem *item, ETLayoutItem *ancestorItem)
+{
+	for (ETLayoutItem *parent = item; parent != nil; parent = [parent parentItem])
+	{
+		if (parent == ancestorItem)
+			return YES;
+	}
+	return NO;
+}
+
+/** Discards the cell values cached for the removed item and its descendants, 
+so they are not retained until the next reload.
+
+Only the cached items are visited, the removed item descendants are not. */
+- (void) didRemoveItem: (ETLayoutItem *)anItem
+{
+	if ([anItem isGroup] == NO)
+	{
+		[self discardCachedValuesForItem: anItem];
+		return;
+	}
+
+	NSMutableArray *discardedItems = [NSMutableArray array];
+
+	for (ETLayoutItem *item in [_cachedValues keyEnumerator])
+	{
+		if (ETIsItemOrDescendantOfItem(item, anItem))
+		{
+			[discardedItems addObject: item];
+		}
+	}
+	for (ETLayoutItem *item in discardedItems)
+	{
+		[self discardCachedValuesForItem: item];
+	}
+}
+
 /** This method is only exposed to be used internally by EtoileUI.
 
 Retrieves the value provided by the item and returns an object value that is 
-compatible with the cell used at the given row/column intersection.  */
+compatible with the cell used at the given row/column intersection.
+
+The object value is cached per item and property, until the item or the table 
+layout is invalidated (see -discardCachedValues). The value is not cached when 
+the item represented object cannot report its changes (see 
+-[ETLayout item:didChangeValueForProperty:]), and all the values are discarded 
+once the cached items outnumber twice the visible rows. */
 - (id) objectValueForTableColumn: (NSTableColumn *)column 
                              row: (NSInteger)rowIndex 
                             item: (ETLayoutItem *)item
 {
 	NSParameterAssert(-1 != rowIndex && ETUndeterminedIndex != rowIndex);
-	id value = [item valueForProperty: [self propertyForColumn: column]];
+	NSString *property = [self propertyForColumn: column];
+	NSMutableDictionary *itemValues = [_cachedValues objectForKey: item];
+	id cachedValue = itemValues[property];
+
+	if (cachedValue != nil)
+		return (cachedValue == [NSNull null] ? nil : cachedValue);
+
+	id value = [item valueForProperty: property];
 
 	//ETLog(@"Returns %@ at %i in %@", value, rowIndex, [[self tableView] primitiveDescription]);
 
@@ -739,24 +903,41 @@ compatible with the cell used at the given row/column intersection.  */
 		But we use -objectValueForObject: because on Mac OS X:
 	    -[NSCell setObjectValue:] tends to copy the object
 	    -[NSImageCell setObjectValue:] only accepts images */
-	return [[column dataCellForRow: rowIndex] objectValueForObject: value];
+	id objectValue = [[column dataCellForRow: rowIndex] objectValueForObject: value];
+
+	if ([self canCacheValueForProperty: property item: item] == NO)
+		return objectValue;
+
+	if (itemValues == nil)
+	{
+		if ([_cachedValues count] >= [self maxCachedItemCount])
+		{
+			[self discardCachedValues];
+		}
+		itemValues = [NSMutableDictionary dictionary];
+		[_cachedValues setObject: itemValues forKey: item];
+	}
+	itemValues[property] = (objectValue != nil ? objectValue : [NSNull null]);
+
+	return objectValue;
 }
 
 - (id) tableView: (NSTableView *)tv 
 	objectValueForTableColumn: (NSTableColumn *)column row: (NSInteger)rowIndex
 {
-	NSArray *items = [[self layoutContext] arrangedItems];
+	id <ETLayoutingContext> context = [self layoutContext];
+	NSUInteger nbOfItems = [context numberOfArrangedItems];
 	
-	if (rowIndex >= [items count])
+	if (rowIndex >= nbOfItems)
 	{
 		ETLog(@"WARNING: Row index %d uncoherent with number of items %d in %@", 
-			(int)rowIndex, (int)[items count], self);
+			(int)rowIndex, (int)nbOfItems, self);
 		return nil;
 	}
 	
 	return [self objectValueForTableColumn: column
 	                                   row: rowIndex
-	                                  item: items[rowIndex]];
+	                                  item: [context arrangedItemAtIndex: rowIndex]];
 }
 
 /** This method is only exposed to be used internally by EtoileUI.
@@ -784,23 +965,25 @@ given row/column intersection.  */
 		return;
 
 	[item setValue: value forProperty: [self propertyForColumn: column]];
+	[self discardCachedValuesForItem: item];
 }
 
 - (void) tableView: (NSTableView *)tv 
 	setObjectValue: (id)value forTableColumn: (NSTableColumn *)column row: (NSInteger)rowIndex
 {
-	NSArray *items = [[self layoutContext] arrangedItems];
+	id <ETLayoutingContext> context = [self layoutContext];
+	NSUInteger nbOfItems = [context numberOfArrangedItems];
 	
-	if (rowIndex >= [items count])
+	if (rowIndex >= nbOfItems)
 	{
 		ETLog(@"WARNING: Row index %d uncoherent with number of items %d in %@", 
-			(int)rowIndex, (int)[items count], self);
+			(int)rowIndex, (int)nbOfItems, self);
 		return;
 	}
 	
 	[self setObjectValue: value
 	      forTableColumn: column
-	                item: items[rowIndex]];
+	                item: [context arrangedItemAtIndex: rowIndex]];
 }
 
 /** Returns YES. See [NSObject(ETLayoutPickAndDropIntegration)] protocol.
@@ -849,7 +1032,7 @@ Note: For now, private method. */
 	   -reloadData called back.
 	   The problem is less critical for ETOutlineLayout because data source 
 	   and delegate methods receives an item in argument rather than a row index. */
-	ETAssert([tv numberOfRows] == [[[self layoutContext] arrangedItems] count]);
+	ETAssert([tv numberOfRows] == [[self layoutContext] numberOfArrangedItems]);
 
 	return result;
 }
@@ -869,7 +1052,7 @@ Note: For now, private method. */
 
 	if (ETUndeterminedIndex != positiveRow && NSTableViewDropOn == op)
 	{
-		dropTarget = [[self layoutContext] arrangedItems][positiveRow];
+		dropTarget = [[self layoutContext] arrangedItemAtIndex: positiveRow];
 	}
 
 	ETDebugLog(@"TABLE - Validate drop at %ld on %@ with dragging source %@ in %@ drag mask %lu drop op %lu",
@@ -909,7 +1092,7 @@ Note: For now, private method. */
 		else
 		{
 			dropOp = NSTableViewDropOn;
-			dropRow = [[[self layoutContext] arrangedItems] indexOfObject: validDropTarget];
+			dropRow = [[self layoutContext] indexOfArrangedItem: validDropTarget];
 
 			if (ETUndeterminedIndex == dropRow)
 			{
@@ -946,7 +1129,7 @@ Note: For now, private method. */
 	
 	if (positiveRow != ETUndeterminedIndex && op == NSTableViewDropOn)
 	{
-		dropTarget = [dropTarget arrangedItems][positiveRow];
+		dropTarget = (ETLayoutItemGroup *)[dropTarget arrangedItemAtIndex: positiveRow];
 	}
 
 	return [[dropTarget actionHandler] handleDropCollection: droppedObject
@@ -1030,11 +1213,10 @@ this delegate method. When -setSortDescriptors: returns, the table view calls
 - (ETLayoutItem *) doubleClickedItem
 {
 	NSTableView *tv = [self tableView];
-	NSArray *layoutItems = [[self layoutContext] arrangedItems];
 
 	ETAssert([tv clickedRow] != -1);
 
-	return layoutItems[[tv clickedRow]];
+	return [[self layoutContext] arrangedItemAtIndex: [tv clickedRow]];
 }
 
 /* Framework Private & Subclassing */
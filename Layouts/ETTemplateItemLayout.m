@@ -349,6 +349,21 @@ Does nothing by default. */
 	return [[self layoutContext] arrangedItems];
 }
 
+- (NSUInteger) numberOfArrangedItems
+{
+	return [[self layoutContext] numberOfArrangedItems];
+}
+
+- (ETLayoutItem *) arrangedItemAtIndex: (NSUInteger)index
+{
+	return [[self layoutContext] arrangedItemAtIndex: index];
+}
+
+- (NSUInteger) indexOfArrangedItem: (ETLayoutItem *)anItem
+{
+	return [[self layoutContext] indexOfArrangedItem: anItem];
+}
+
 - (NSArray *) exposedItems
 {
 	return [[self layoutContext] exposedItems];
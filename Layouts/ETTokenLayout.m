@@ -252,7 +252,7 @@ The resizing isn't delegated to the positional layout unlike in ETTemplateItemLa
 	return nil;
 }
 
-- (void) render: (NSMutableDictionary *)inputValues
+- (void) render: (ETRenderContext *)renderContext
      layoutItem: (ETLayoutItem *)item
 	  dirtyRect: (NSRect)dirtyRect
 {
@@ -194,11 +194,16 @@
 		[ETPropertyDescription descriptionWithName: @"separatorTemplateItem" type: (id)@"ETLayoutItem"];
 	ETPropertyDescription *separatorItemEndMargin =
 		[ETPropertyDescription descriptionWithName: @"separatorItemEndMargin" type: (id)@"CGFloat"];
+	ETPropertyDescription *virtualizesItems =
+		[ETPropertyDescription descriptionWithName: @"virtualizesItems" type: (id)@"BOOL"];
+	ETPropertyDescription *virtualizationMargin =
+		[ETPropertyDescription descriptionWithName: @"virtualizationMargin" type: (id)@"CGFloat"];
 	
 	NSArray *transientProperties = @[];
 	NSArray *persistentProperties = @[borderMargin, itemMargin, autoresizesItemToFill,
 		horizontalAlignment, horizontalAligmentGuide, computesItemRectFromBoundingBox,
-		usesAlignmentHint, separatorTemplateItem, separatorItemEndMargin];
+		usesAlignmentHint, separatorTemplateItem, separatorItemEndMargin,
+		virtualizesItems, virtualizationMargin];
 	
 	[entity setUIBuilderPropertyNames: (id)[[@[borderMargin, itemMargin,
 		autoresizesItemToFill, horizontalAlignment, horizontalAligmentGuide,
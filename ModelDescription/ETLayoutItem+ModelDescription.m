@@ -249,6 +249,8 @@
 	// NOTE: _wasViewHidden must be persisted. If YES at deserialization, we 
 	// unhide the item view.
 	ETPropertyDescription *wasViewHidden = [ETPropertyDescription descriptionWithName: @"wasViewHidden" type: (id)@"BOOL"];
+	ETPropertyDescription *usesSpatialIndex = 
+		[ETPropertyDescription descriptionWithName: @"usesSpatialIndex" type: (id)@"BOOL"];
 
 	/* Transient Properties */
 	
@@ -291,11 +293,12 @@
 	   This explains why we don't persist the arranged items. */
 
 	NSArray *persistentProperties = @[items, layout, source, delegate, controller,
-		doubleAction, shouldMutateRepObject, itemScaleFactor, wasViewHidden];
+		doubleAction, shouldMutateRepObject, itemScaleFactor, wasViewHidden,
+		usesSpatialIndex];
 	NSArray *transientProperties = @[doubleClickedItem];
 
 	[entity setUIBuilderPropertyNames: (id)[[@[delegate, doubleAction,
-		shouldMutateRepObject, itemScaleFactor] mappedCollection] name]];
+		shouldMutateRepObject, itemScaleFactor, usesSpatialIndex] mappedCollection] name]];
 	
 	[[persistentProperties mappedCollection] setPersistent: YES];
 	[entity setPropertyDescriptions: [persistentProperties arrayByAddingObjectsFromArray: transientProperties]];
@@ -617,6 +617,8 @@ static NSString *representedUnorderedAttributeKey = @"representedUnorderedAttrib
 	// TODO: May be reset the bounding box if not persisted
 	//_boundingBox = ETNullRect;
 	[self prepareTransientState];
+	/* The parent item or the ancestor layouts can change with deserialization */
+	[self invalidateOpaqueLayoutForValueChanges];
 	/* We ensure the supervisor view geometry (flipped, frame and autoresizing) 
 	   is synchronized with the receiver, since item geometry can change with 
 	   deserialization.
@@ -19,12 +19,10 @@ Unlike the Collage example where the UI is built with EtoileUI from scratch,
 PhotoViewExample illustrates how to reuse an AppKit UI packaged in a Nib 
 (usually built with IB or Gorm).
 
-PhotoViewExample illustrates how an AppKit widget can be reused. Every photo 
-item uses an NSImageView returned by -imageViewForImage: to present the image. 
-The image view is set with -[ETLayoutItem setView:].<br />
-In a real application, use -[ETLayoutItem setImage:] and no view. Using no view 
-will substantially improve the overall performance. The image drawing can be 
-then customized with ETBasicItemStyle and -[ETLayoutItem setContentAspect:]. 
+Every photo item uses no view, but draws its image with ETBasicItemStyle. The 
+image files are decoded and downscaled in the background with ETImageLoader, 
+so choosing many pictures doesn't block the UI. The image drawing can be 
+customized with ETBasicItemStyle and -[ETLayoutItem setContentAspect:]. 
 
 The entire application behavior is implemented in a single controller object 
 (PhotoViewController) which is instantiated/stored in the main Nib and sets as 
@@ -78,7 +76,7 @@ is shown in MarkupEditorExample. */
 	IBOutlet NSSlider *itemMarginSlider;
 	IBOutlet NSSlider *borderMarginSlider;
 	ETLayoutItemGroup *photoViewItem;
-	NSMutableArray *images;
+	NSMutableArray *imagePaths;
 }
 
 - (IBAction) choosePicturesAndLayout:(id)sender;
@@ -97,12 +95,12 @@ is shown in MarkupEditorExample. */
                         returnCode: (int)returnCode
                        contextInfo: (void *)contextInfo;
 - (void) setUpLayoutItemsDirectly;
-- (NSImageView *) imageViewForImage: (NSImage *)image;
 
 @end
 
 
 @interface PhotoAsset : NSObject
+@property (nonatomic, retain) NSString *path;
 @property (nonatomic, readonly) NSImage *icon;
 @property (nonatomic, retain) NSImage *image;
 @property (nonatomic, retain) NSString *name;
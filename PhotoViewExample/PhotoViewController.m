@@ -9,8 +9,7 @@
 #import "PhotoViewController.h"
 #import <EtoileUI/ETUIItemIntegration.h>
 #import <EtoileUI/ETView.h>
-
-#define USE_IMG_VIEW
+#import <EtoileUI/ETImageLoader.h>
 
 @implementation PhotoViewController
 
@@ -20,7 +19,7 @@
 	if (self == nil)
 		return nil;
 
-	images = [[NSMutableArray alloc] init];
+	imagePaths = [[NSMutableArray alloc] init];
 	return self;
 }
 
@@ -210,35 +209,13 @@ UI level for a photo viewer. */
 {
     //ETLog(@"Pictures selected: %@\n", paths);
 	
-	[images removeAllObjects];
+	[imagePaths removeAllObjects];
     
+	/* The images are decoded in the background once the items are created, 
+	   see -photoItemWithPath: */
     for (NSURL *URL in [panel URLs])
     {
-		NSString *path = [URL path];
-        NSImage *image = AUTORELEASE([[NSImage alloc] initWithContentsOfFile: path]);
-		
-		if (image == nil)
-			continue;
-
-		//ETLog(@"New image loaded: %@\n", image);
-		
-		// NOTE: NSImage retains image on -setName:
-		if ([NSImage imageNamed: path] != nil)
-		{
-			/* Reuse already registered image */
-			[images addObject: [NSImage imageNamed: path]];
-		}
-		else /* Register image */
-		{
-			if ([image setName: path])
-			{
-				[images addObject: image];
-			}
-			else
-			{
-				ETLog(@"Impossible to register image for name %@", path);
-			}
-		}
+		[imagePaths addObject: [URL path]];
     }        
 	
 	if ([photoViewItem source] == nil)
@@ -250,28 +227,43 @@ UI level for a photo viewer. */
     [photoViewItem reloadAndUpdateLayout];
 }
 
-- (PhotoAsset *)photoAssetWithImage: (NSImage *)img
+- (PhotoAsset *)photoAssetWithPath: (NSString *)path
 {
 	PhotoAsset *asset = AUTORELEASE([PhotoAsset new]);
 	NSString *appName = nil;
 	NSString *type = nil;
 	
-	[[NSWorkspace sharedWorkspace] getInfoForFile: [img name]
+	[[NSWorkspace sharedWorkspace] getInfoForFile: path
 	                                  application: &appName
 	                                         type: &type];
 
 	NSDictionary *info =
-		[[NSFileManager defaultManager] attributesOfItemAtPath: [img name]
+		[[NSFileManager defaultManager] attributesOfItemAtPath: path
 	                                                     error: NULL];
 	
-	[asset setName: [[img name] lastPathComponent]];
+	[asset setPath: path];
+	[asset setName: [path lastPathComponent]];
 	[asset setModificationDate: [info objectForKey: NSFileModificationDate]];
 	[asset setType: type];
-	[asset setImage: img];
 
 	return asset;
 }
 
+/* Returns a new photo item whose image is loaded in the background.
+
+Until the image is loaded, the item shows the image loader placeholder image. 
+ETImageLoader sets the image on the photo asset, since PhotoAsset declares an 
+'image' property. */
+- (ETLayoutItem *) photoItemWithPath: (NSString *)path
+{
+	ETLayoutItem *item = [[ETLayoutItemFactory factory] item];
+
+	[item setRepresentedObject: [self photoAssetWithPath: path]];
+	[[ETImageLoader sharedInstance] loadImageAtPath: path forItem: item];
+
+	return item;
+}
+
 /* When no source is set, this method is called by -selectPicturePanelDidEnd:XXX 
 to build layout items and adds them to the photo view directly.
 
@@ -287,20 +279,15 @@ protocol methods. */
 	
 	ETLog(@"Set up layout items directly...");
 	
-	for (NSImage *img in images)
+	for (NSString *path in imagePaths)
 	{
-		ETLayoutItem *item =
-			[[ETLayoutItemFactory factory] itemWithView: [self imageViewForImage: img]];
-
-		 /* Use the image as the item model
+		 /* Use the photo asset as the item model
 		 
 		    Property values set on the item itself (with -setImage:, -setIcon:, 
 			-setName: etc.) won't be visible at the UI level, because property 
 			values are retrieved through -[ETLayoutItem valueForProperty:] which 
 			only looks them up on the represented object when one is set. */
-		[item setRepresentedObject: [self photoAssetWithImage: img]];
-
-		[imageItems addObject: item];
+		[imageItems addObject: [self photoItemWithPath: path]];
 	}
 
 	/* Remove all the items added previously */
@@ -308,23 +295,6 @@ protocol methods. */
 	[photoViewItem addItems: imageItems];
 }
 
-- (NSImageView *) imageViewForImage: (NSImage *)image
-{
-#ifdef USE_IMG_VIEW
-	if (image == nil)
-		return nil;
-
-	NSImageView *view = AUTORELEASE([[NSImageView alloc] 
-		initWithFrame: ETMakeRect(NSZeroPoint, [image size])]);
-	
-	[view setImage: image];
-
-	return view;
-#else
-	return nil;
-#endif
-}
-
 /* ETLayoutItemGroup Source Protocol as a variant to -setUpLayoutItemsDirectly. 
 
    Will be called back in reaction to -reloadXXX when [photoViewItem source] is 
@@ -332,9 +302,9 @@ protocol methods. */
 
 - (int) baseItem: (ETLayoutItemGroup *)baseItem numberOfItemsInItemGroup: (ETLayoutItemGroup *)itemGroup
 {
-	ETLog(@"Returns %d as number of items in %@", (int)[images count], baseItem);
+	ETLog(@"Returns %d as number of items in %@", (int)[imagePaths count], baseItem);
 
-	return [images count];
+	return [imagePaths count];
 }
 
 /* Both baseItem and itemGroup are the same because the base item is photo view 
@@ -343,13 +313,10 @@ protocol methods. */
                 itemAtIndex: (NSUInteger)index 
                 inItemGroup: (ETLayoutItemGroup *)itemGroup
 {
-	NSImage *img = [images objectAtIndex: index];
-	ETLayoutItem *imageItem =
-		[[ETLayoutItemFactory factory] itemWithView: [self imageViewForImage: img]];
+	ETLayoutItem *imageItem = [self photoItemWithPath: [imagePaths objectAtIndex: index]];
 
 	//ETLog(@"Returns %@ as item in %@", imageItem, baseItem);
 
-	[imageItem setRepresentedObject: [self photoAssetWithImage: img]];
 	[imageItem setSubtype: [ETUTI typeWithString: @"public.image"]];
 
 	return imageItem;
@@ -368,7 +335,7 @@ protocol methods. */
 - (NSArray *) propertyNames
 {
 	return [[super propertyNames]
-		arrayByAddingObjectsFromArray: @[@"name", @"size", @"type", @"modificationDate"]];
+		arrayByAddingObjectsFromArray: @[@"name", @"image", @"size", @"type", @"modificationDate"]];
 }
 
 /* -[ETBasicItemStyle imageForItem:] returns -icon and not -image by default, 
@@ -10,6 +10,7 @@
 #import "ETDecoratorItem.h"
 #import "ETActionHandler.h" /* For +sharedFallbackResponder */
 #import "ETGeometry.h"
+#import "ETRenderContext.h"
 #import "ETUIItem.h"
 #import "ETUIItemIntegration.h"
 #import "ETView.h"
@@ -113,8 +114,8 @@ By default, returns YES. */
 // TODO: To be used, when EtoileUI will draw everything by itself including the 
 // views without relying on the view hierarchy machinery.
 //NSRect rectInContent = [self convertDecoratorRectToContent: dirtyRect];
-//[_decoratedItem render: inputValues dirtyRect: rectInContent inContext: ctxt];
-- (void) render: (NSMutableDictionary *)inputValues 
+//[_decoratedItem render: renderContext dirtyRect: rectInContent inContext: ctxt];
+- (void) render: (ETRenderContext *)renderContext 
       dirtyRect: (NSRect)dirtyRect 
       inContext: (id)ctxt
 {
@@ -128,12 +129,13 @@ By default, returns YES. */
 	if ([item isLayoutItem] == NO)
 		return;
 
+	renderContext = [ETRenderContext renderContextWithInputValues: renderContext];
+
 	/* See also -[ETLayoutItem render:dirtyRect:inContext:] */
-	[NSGraphicsContext saveGraphicsState];
-	[[NSBezierPath bezierPathWithRect: dirtyRect] setClip];
+	[renderContext pushRenderState: (ETRenderState){ ETIdentityTransform(), dirtyRect }];
 	//[self drawCoverStyleMarkerWithRect: realDirtyRect];
-	[[item coverStyle] render: inputValues layoutItem: item dirtyRect: dirtyRect];
-	[NSGraphicsContext restoreGraphicsState];
+	[[item coverStyle] render: renderContext layoutItem: item dirtyRect: dirtyRect];
+	[renderContext popRenderState];
 }
 
 /** <override-never /> 
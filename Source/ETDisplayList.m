@@ -0,0 +1,76 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <EtoileFoundation/Macros.h>
+#import "ETDisplayList.h"
+#import "ETGraphicsBackend.h"
+#import "ETCompatibility.h"
+
+@implementation ETDisplayList
+
+@synthesize inputs = _inputs;
+
+- (instancetype) initWithInputs: (ETDisplayListInputs)inputs
+{
+	SUPERINIT;
+	_inputs = inputs;
+	_commands = [NSMutableArray new];
+	return self;
+}
+
+- (instancetype) init
+{
+	return [self initWithInputs: (ETDisplayListInputs){ 0 }];
+}
+
+- (NSString *) description
+{
+	return [NSString stringWithFormat: @"%@ count %lu styleRevision %lu",
+		[super description], (unsigned long)[_commands count],
+		(unsigned long)_inputs.styleRevision];
+}
+
+- (NSUInteger) count
+{
+	return [_commands count];
+}
+
+/** Appends a copy of the given command.
+
+The command is not executed, see -[ETRenderContext draw:]. */
+- (void) addCommand: (ETDrawingCommand)aCommand
+{
+	NILARG_EXCEPTION_TEST(aCommand);
+	[_commands addObject: [aCommand copy]];
+}
+
+/** Returns whether the recorded commands would draw the same output as
+rendering again with the given inputs. */
+- (BOOL) isValidForInputs: (ETDisplayListInputs)inputs
+{
+	return (_inputs.styleRevision == inputs.styleRevision
+		&& NSEqualRects(_inputs.contentBounds, inputs.contentBounds)
+		&& NSEqualRects(_inputs.boundingBox, inputs.boundingBox)
+		&& _inputs.flipped == inputs.flipped
+		&& _inputs.selected == inputs.selected
+		&& _inputs.firstResponder == inputs.firstResponder
+		&& _inputs.drawsSelectionIndicator == inputs.drawsSelectionIndicator
+		&& _inputs.drawsFirstResponderIndicator == inputs.drawsFirstResponderIndicator);
+}
+
+/** Executes the recorded commands in the order they were added, in the
+current graphics context. */
+- (void) replay
+{
+	for (ETDrawingCommand command in _commands)
+	{
+		command();
+	}
+}
+
+@end
@@ -333,7 +333,7 @@ NSString *kETManipulatedObjectProperty = @"manipulatedObject";
 	return [NSImage imageNamed: @"layer-select-point"];
 }
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item
       dirtyRect: (NSRect)dirtyRect
 {
@@ -673,13 +673,13 @@ or not. */
 
 
 /** Draws the receiver style. See ETStyle. */
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
 	  dirtyRect: (NSRect)dirtyRect
       inContext: (id)ctxt
 {
 	[self drawOutlineInRect: [self contentBounds]];
 	/* Now draw the handles that are our children */
-	[super render: inputValues dirtyRect: dirtyRect inContext: ctxt];
+	[super render: renderContext dirtyRect: dirtyRect inContext: ctxt];
 }
 
 /** Draws a rectangular outline. */
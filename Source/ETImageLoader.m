@@ -0,0 +1,386 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <EtoileFoundation/Macros.h>
+#import "ETImageLoader.h"
+#import "ETGeometry.h"
+#import "ETLayoutItem.h"
+#import "ETLayoutItemGroup.h"
+#import "NSImage+NiceScaling.h"
+#import "EtoileUIProperties.h"
+#import "ETCompatibility.h"
+
+#define DEFAULT_MAX_IMAGE_SIZE NSMakeSize(512, 512)
+
+@interface ETImageLoader ()
+- (void) operationDidFinish: (NSOperation *)anOperation;
+@end
+
+/* Decodes and downscales an image file on a background thread */
+@interface ETImageLoadOperation : NSOperation
+{
+	@public
+	ETImageLoader *_loader;
+	NSString *_path;
+	NSSize _maxImageSize;
+	__weak ETLayoutItem *_item;
+	NSBitmapImageRep *_imageRep;
+}
+@end
+
+/* Returns whether ETDownscaledImageRep() can read the pixels of the given 
+image rep. */
+static BOOL ETCanDownscaleImageRep(NSBitmapImageRep *aRep)
+{
+	NSString *colorSpaceName = [aRep colorSpaceName];
+	BOOL isRGB = ([colorSpaceName isEqual: NSDeviceRGBColorSpace]
+		|| [colorSpaceName isEqual: NSCalibratedRGBColorSpace]);
+	BOOL isGray = ([colorSpaceName isEqual: NSDeviceWhiteColorSpace]
+		|| [colorSpaceName isEqual: NSCalibratedWhiteColorSpace]);
+	NSInteger nbOfColorSamples = [aRep samplesPerPixel] - ([aRep hasAlpha] ? 1 : 0);
+
+	if ([aRep bitmapFormat] & NSFloatingPointSamplesBitmapFormat)
+		return NO;
+
+	return ((isRGB && nbOfColorSamples == 3) || (isGray && nbOfColorSamples == 1))
+		&& [aRep bitsPerSample] <= 16;
+}
+
+/* Reads the pixel at the given location as premultiplied 8 bits RGBA samples.
+
+Non-planar 8 bits samples are read directly from the bitmap data, other 
+layouts go through -getPixel:atX:y:. */
+static inline void ETGetPixel(NSBitmapImageRep *aRep, unsigned char *data, 
+	BOOL isDirectAccess, NSInteger x, NSInteger y, NSUInteger rgba[4])
+{
+	NSInteger samplesPerPixel = [aRep samplesPerPixel];
+	NSUInteger samples[5];
+
+	if (isDirectAccess)
+	{
+		unsigned char *pixel = data + y * [aRep bytesPerRow] + x * samplesPerPixel;
+
+		for (NSInteger i = 0; i < samplesPerPixel; i++)
+		{
+			samples[i] = pixel[i];
+		}
+	}
+	else
+	{
+		NSInteger shift = [aRep bitsPerSample] - 8;
+
+		[aRep getPixel: samples atX: x y: y];
+
+		for (NSInteger i = 0; i < samplesPerPixel; i++)
+		{
+			samples[i] = (shift >= 0 ? samples[i] >> shift : (samples[i] * 255) / ((1 << [aRep bitsPerSample]) - 1));
+		}
+	}
+
+	NSBitmapFormat format = [aRep bitmapFormat];
+	BOOL hasAlpha = [aRep hasAlpha];
+	BOOL isAlphaFirst = (hasAlpha && (format & NSAlphaFirstBitmapFormat));
+	NSUInteger *colorSamples = samples + (isAlphaFirst ? 1 : 0);
+	NSUInteger alpha = (hasAlpha ? samples[isAlphaFirst ? 0 : samplesPerPixel - 1] : 255);
+	BOOL isGray = (samplesPerPixel - (hasAlpha ? 1 : 0) == 1);
+
+	rgba[0] = colorSamples[0];
+	rgba[1] = colorSamples[isGray ? 0 : 1];
+	rgba[2] = colorSamples[isGray ? 0 : 2];
+	rgba[3] = alpha;
+
+	if (hasAlpha && (format & NSAlphaNonpremultipliedBitmapFormat))
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			rgba[i] = (rgba[i] * alpha) / 255;
+		}
+	}
+}
+
+/* Returns a copy of the given image rep downscaled to the given size in pixels.
+
+Each destination pixel is the average of the source pixels it covers. The 
+bitmap data is accessed directly, since drawing through an NSGraphicsContext 
+is not safe outside the main thread. */
+static NSBitmapImageRep *ETDownscaledImageRep(NSBitmapImageRep *aRep, NSSize aSize)
+{
+	NSInteger srcWidth = [aRep pixelsWide];
+	NSInteger srcHeight = [aRep pixelsHigh];
+	NSInteger width = MAX(1, round(aSize.width));
+	NSInteger height = MAX(1, round(aSize.height));
+	NSBitmapImageRep *scaledRep =
+		[[NSBitmapImageRep alloc] initWithBitmapDataPlanes: NULL
+		                                        pixelsWide: width
+		                                        pixelsHigh: height
+		                                     bitsPerSample: 8
+		                                   samplesPerPixel: 4
+		                                          hasAlpha: YES
+		                                          isPlanar: NO
+		                                    colorSpaceName: NSDeviceRGBColorSpace
+		                                       bytesPerRow: 0
+		                                      bitsPerPixel: 0];
+	unsigned char *srcData = [aRep bitmapData];
+	unsigned char *data = [scaledRep bitmapData];
+	NSInteger bytesPerRow = [scaledRep bytesPerRow];
+	BOOL isDirectAccess = ([aRep bitsPerSample] == 8 && [aRep isPlanar] == NO);
+
+	for (NSInteger y = 0; y < height; y++)
+	{
+		NSInteger minY = (y * srcHeight) / height;
+		NSInteger maxY = MAX(minY + 1, ((y + 1) * srcHeight) / height);
+
+		for (NSInteger x = 0; x < width; x++)
+		{
+			NSInteger minX = (x * srcWidth) / width;
+			NSInteger maxX = MAX(minX + 1, ((x + 1) * srcWidth) / width);
+			NSUInteger sum[4] = { 0, 0, 0, 0 };
+			NSUInteger rgba[4];
+
+			for (NSInteger srcY = minY; srcY < maxY; srcY++)
+			{
+				for (NSInteger srcX = minX; srcX < maxX; srcX++)
+				{
+					ETGetPixel(aRep, srcData, isDirectAccess, srcX, srcY, rgba);
+
+					for (int i = 0; i < 4; i++)
+					{
+						sum[i] += rgba[i];
+					}
+				}
+			}
+
+			NSUInteger count = (maxX - minX) * (maxY - minY);
+			unsigned char *pixel = data + y * bytesPerRow + x * 4;
+
+			for (int i = 0; i < 4; i++)
+			{
+				pixel[i] = sum[i] / count;
+			}
+		}
+	}
+	return scaledRep;
+}
+
+/* Returns the given image rep once decoded, or a decoded copy downscaled to 
+fit the given size in pixels.
+
+Image reps whose pixels cannot be read directly (e.g. CMYK or floating point 
+samples) are not downscaled. */
+static NSBitmapImageRep *ETDecodedImageRep(NSBitmapImageRep *aRep, NSSize maxSize)
+{
+	NSSize pixelSize = NSMakeSize([aRep pixelsWide], [aRep pixelsHigh]);
+	BOOL fits = (pixelSize.width <= maxSize.width && pixelSize.height <= maxSize.height);
+
+	if (NSEqualSizes(maxSize, ETNullSize) || fits || ETCanDownscaleImageRep(aRep) == NO)
+	{
+		/* Forces the decoding */
+		[aRep bitmapData];
+		return aRep;
+	}
+
+	return ETDownscaledImageRep(aRep, [NSImage scaledSize: pixelSize toFitSize: maxSize]);
+}
+
+@implementation ETImageLoadOperation
+
+- (void) main
+{
+	if ([self isCancelled] == NO)
+	{
+		@autoreleasepool
+		{
+			NSData *data = [NSData dataWithContentsOfFile: _path];
+			NSBitmapImageRep *rep = (data != nil ? [NSBitmapImageRep imageRepWithData: data] : nil);
+
+			if (rep != nil)
+			{
+				_imageRep = ETDecodedImageRep(rep, _maxImageSize);
+			}
+			else
+			{
+				ETLog(@"WARNING: Failed to decode image at %@", _path);
+			}
+		}
+	}
+	[_loader operationDidFinish: self];
+}
+
+@end
+
+
+@implementation ETImageLoader
+
+@synthesize placeholderImage = _placeholderImage, maxImageSize = _maxImageSize;
+
+static ETImageLoader *sharedInstance = nil;
+
++ (void) initialize
+{
+	if ([self isEqual: [ETImageLoader class]] == NO)
+		return;
+
+	sharedInstance = [[self alloc] init];
+}
+
+/** Returns the shared image loader. */
++ (instancetype) sharedInstance
+{
+	return sharedInstance;
+}
+
+- (instancetype) init
+{
+	SUPERINIT;
+	_queue = [[NSOperationQueue alloc] init];
+	[_queue setName: @"org.etoile-project.EtoileUI.ETImageLoader"];
+	_operationsByItem = [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+	                                          valueOptions: NSPointerFunctionsStrongMemory];
+	_loadedImages = [[NSMutableArray alloc] init];
+	_maxImageSize = DEFAULT_MAX_IMAGE_SIZE;
+	return self;
+}
+
+- (NSOperationQueuePriority) queuePriorityForItem: (ETLayoutItem *)anItem
+{
+	return ([anItem isVisible] ? NSOperationQueuePriorityHigh : NSOperationQueuePriorityNormal);
+}
+
+/** Starts to decode the image file at the given path on a background thread, 
+and sets -placeholderImage as the item image until the decoded image is 
+delivered.
+
+A previous load for the same item is cancelled. */
+- (void) loadImageAtPath: (NSString *)aPath forItem: (ETLayoutItem *)anItem
+{
+	NILARG_EXCEPTION_TEST(aPath);
+	NILARG_EXCEPTION_TEST(anItem);
+
+	[self cancelLoadingForItem: anItem];
+
+	ETImageLoadOperation *operation = [[ETImageLoadOperation alloc] init];
+
+	operation->_loader = self;
+	operation->_path = [aPath copy];
+	operation->_maxImageSize = _maxImageSize;
+	operation->_item = anItem;
+	[operation setQueuePriority: [self queuePriorityForItem: anItem]];
+
+	[_operationsByItem setObject: operation forKey: anItem];
+	[anItem setValue: _placeholderImage forProperty: kETImageProperty];
+	[_queue addOperation: operation];
+}
+
+/** Cancels the pending load for the given item.
+
+The item keeps its current image, usually -placeholderImage. */
+- (void) cancelLoadingForItem: (ETLayoutItem *)anItem
+{
+	[[_operationsByItem objectForKey: anItem] cancel];
+	[_operationsByItem removeObjectForKey: anItem];
+}
+
+/** Returns whether an image is being loaded for the given item. */
+- (BOOL) isLoadingForItem: (ETLayoutItem *)anItem
+{
+	return ([_operationsByItem objectForKey: anItem] != nil);
+}
+
+/* Moves the pending loads for the visible items to the front of the queue. */
+- (void) updateQueuePriorities
+{
+	for (ETLayoutItem *item in _operationsByItem)
+	{
+		NSOperation *operation = [_operationsByItem objectForKey: item];
+
+		if ([operation isExecuting] || [operation isFinished])
+			continue;
+
+		[operation setQueuePriority: [self queuePriorityForItem: item]];
+	}
+}
+
+/* Collects the finished operation on a background thread, and schedules a 
+delivery on the main thread unless one is already pending. */
+- (void) operationDidFinish: (NSOperation *)anOperation
+{
+	BOOL schedulesDelivery = NO;
+
+	@synchronized (_loadedImages)
+	{
+		[_loadedImages addObject: anOperation];
+		schedulesDelivery = (_isDeliveryScheduled == NO);
+		_isDeliveryScheduled = YES;
+	}
+
+	if (schedulesDelivery)
+	{
+		[self performSelectorOnMainThread: @selector(deliverLoadedImages)
+		                       withObject: nil
+		                    waitUntilDone: NO];
+	}
+}
+
+/** Sets the images decoded since the last delivery on their items, then 
+redisplays each parent item once.
+
+Loads that were cancelled or replaced by a new load for the same item are 
+ignored.
+
+This method is called on the main thread once some images are decoded. The 
+images decoded meanwhile are delivered together. */
+- (void) deliverLoadedImages
+{
+	NSArray *operations = nil;
+
+	@synchronized (_loadedImages)
+	{
+		operations = [_loadedImages copy];
+		[_loadedImages removeAllObjects];
+		_isDeliveryScheduled = NO;
+	}
+
+	NSHashTable *invalidatedItems = [NSHashTable hashTableWithOptions: NSPointerFunctionsObjectPointerPersonality];
+
+	for (ETImageLoadOperation *operation in operations)
+	{
+		ETLayoutItem *item = operation->_item;
+
+		if (item == nil || [_operationsByItem objectForKey: item] != operation)
+			continue;
+
+		[_operationsByItem removeObjectForKey: item];
+
+		if (operation->_imageRep == nil)
+			continue;
+
+		NSImage *image = [[NSImage alloc] initWithSize: [operation->_imageRep size]];
+
+		[image addRepresentation: operation->_imageRep];
+		[item setValue: image forProperty: kETImageProperty];
+		[invalidatedItems addObject: ([item parentItem] != nil ? [item parentItem] : item)];
+	}
+
+	for (ETLayoutItem *item in invalidatedItems)
+	{
+		[item setNeedsDisplay: YES];
+	}
+
+	[self updateQueuePriorities];
+}
+
+/** Blocks until all the pending images are decoded, then delivers them.
+
+Must be called on the main thread. */
+- (void) waitUntilAllImagesAreLoaded
+{
+	[_queue waitUntilAllOperationsAreFinished];
+	[self deliverLoadedImages];
+}
+
+@end
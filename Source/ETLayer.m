@@ -64,15 +64,11 @@ If a window decorator is bound to the item, the display view is the window view
 (NSThemeFrame on Mac OS X). Removing NSThemeFrame results in a weird behavior, 
 the window remains visible but a -lockFocus assertion is thrown on mouse down. */
 - (void) updateExposedViewsForItems: (NSArray *)items
-                     exposedIndexes: (NSIndexSet *)exposedIndexes
-                   unexposedIndexes: (NSIndexSet *)unexposedIndexes
 {
 	if ([[self layout] isKindOfClass: [ETWindowLayout class]])
 		return;
 
-	[super updateExposedViewsForItems: items
-	                   exposedIndexes: exposedIndexes
-	                 unexposedIndexes: unexposedIndexes];
+	[super updateExposedViewsForItems: items];
 }
 
 - (void) didAttachItem: (ETLayoutItem *)item
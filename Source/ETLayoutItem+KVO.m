@@ -86,6 +86,10 @@ that contains this empty string as the new value. */
 		
 		/* Allow the item to redisplay any visual element that depends on the value 
 		   e.g. a style or a cell in a layout view */
+		[self discardDisplayList];
+		/* The represented object property is presented as an item property 
+		   by opaque layouts (e.g. a table column) */
+		[[self opaqueLayoutForValueChanges] item: self didChangeValueForProperty: keyPath];
 		[self refreshIfNeeded];
 	}
 }
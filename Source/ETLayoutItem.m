@@ -27,6 +27,7 @@
 #import "ETLayoutItem+Scrollable.h"
 #import "ETLayoutExecutor.h"
 #import "ETPositionalLayout.h"
+#import "ETRenderContext.h"
 #import "EtoileUIProperties.h"
 #import "ETScrollableAreaItem.h"
 #import "ETStyleGroup.h"
@@ -55,6 +56,8 @@ NSString *ETLayoutItemLayoutDidChangeNotification = @"ETLayoutItemLayoutDidChang
 @property (nonatomic, readonly) NSRect bounds;
 - (void) setBoundsSize: (NSSize)size;
 @property (nonatomic, readonly) NSPoint centeredAnchorPoint;
+- (void) renderStyleGroupWithDisplayList: (ETRenderContext *)renderContext
+                               dirtyRect: (NSRect)dirtyRect;
 @end
 
 @implementation ETLayoutItem
@@ -352,6 +355,20 @@ See ETController and ETPickAndDropActionHandler. */
     return (parent != nil ? parent : [self hostItem]);
 }
 
+/** Returns the index in the parent item children, as computed the last time 
+the parent item children were renumbered.
+
+The returned index can be invalid, see -[ETLayoutItemGroup indexOfItem:]. */
+- (NSUInteger) cachedIndexInParentItem
+{
+	return _cachedIndexInParentItem;
+}
+
+- (void) setCachedIndexInParentItem: (NSUInteger)anIndex
+{
+	_cachedIndexInParentItem = anIndex;
+}
+
 /** Detaches the receiver from the item group it belongs to.
 
 You are in charge of retaining the receiver, otherwise it could be deallocated 
@@ -1163,6 +1180,7 @@ If -isSelectable returns NO, the new selection state is not set. */
 	_selected = selected;
 	ETDebugLog(@"Set layout item selection state %@", self);
 	[self didChangeValueForKey: kETSelectedProperty];
+	[[self parentItem] didChangeSelectionStateOfItem: self];
 }
 
 /** Returns the receiver selection state. See also -setSelected:. */
@@ -1252,7 +1270,7 @@ See also -exposed. */
 
 	[self willChangeValueForProperty: kETExposedProperty];
 	_exposed = exposed;
-	[self willChangeValueForProperty: kETExposedProperty];
+	[self didChangeValueForProperty: kETExposedProperty];
 }
 
 /** Returns whether the receiver should be displayed or not.
@@ -1448,6 +1466,64 @@ To retrieve the enclosing window item, use
 	return windowDecorator;
 }
 
+/** This method is only exposed to be used internally by EtoileUI.
+
+Discards the opaque layout cached by the receiver and its descendant items with 
+-opaqueLayoutForValueChanges.
+
+Must be called when the parent item of the receiver or the layout of an 
+ancestor item changes. */
+- (void) invalidateOpaqueLayoutForValueChanges
+{
+	_opaqueLayout = nil;
+	_hasCachedOpaqueLayout = NO;
+}
+
+/** This method is only exposed to be used internally by EtoileUI.
+
+Returns whether -opaqueLayoutForValueChanges is cached. */
+- (BOOL) hasCachedOpaqueLayout
+{
+	return _hasCachedOpaqueLayout;
+}
+
+/** This method is only exposed to be used internally by EtoileUI.
+
+Returns the layout of the closest ancestor item whose layout returns YES to 
+-isOpaque, or nil if there is none.
+
+The result is cached until -invalidateOpaqueLayoutForValueChanges is called, so 
+property changes don't walk the ancestor items on every frame or position 
+update. */
+- (ETLayout *) opaqueLayoutForValueChanges
+{
+	if (_hasCachedOpaqueLayout)
+		return _opaqueLayout;
+
+	ETLayoutItemGroup *parent = [self parentItem];
+	ETLayout *parentLayout = [parent layout];
+	/* The parent result is always cached, so invalidating an item group can 
+	   skip the descendants when the item group has no cached result */
+	ETLayout *ancestorLayout = [parent opaqueLayoutForValueChanges];
+
+	_opaqueLayout = ([parentLayout isOpaque] ? parentLayout : ancestorLayout);
+	_hasCachedOpaqueLayout = YES;
+
+	return _opaqueLayout;
+}
+
+/** Notifies the closest ancestor opaque layout about the property change, and 
+discards the display list, in addition to the superclass behavior.
+
+Opaque layouts such as ETTableLayout can cache item values to draw their rows, 
+see -[ETLayout item:didChangeValueForProperty:]. */
+- (void) didChangeValueForProperty: (NSString *)key
+{
+	[super didChangeValueForProperty: key];
+	[self discardDisplayList];
+	[[self opaqueLayoutForValueChanges] item: self didChangeValueForProperty: key];
+}
+
 /** Returns the topmost ancestor layout item, including itself, whose layout 
 returns YES to -isOpaque (see ETLayout). If none is found, returns self. */
 - (ETLayoutItemGroup *) ancestorItemForOpaqueLayout
@@ -1608,19 +1684,22 @@ entirely redrawn and the portion to redraw intersects the receiver area
 Warning: When -decoratorItem is not nil, the receiver coordinate space is not  
 equal to the receiver content coordinate space.
 
-inputValues is a key/value pair list that is initially passed to the ancestor 
-item on which the rendering was started. You can add or remove key/value pairs  
-to let styles know how they are expected to be rendered.<br />
-This key/value pair list will be carried downwards until the rendering is finished.
+renderContext is initially passed to the ancestor item on which the rendering 
+was started, and carried downwards until the rendering is finished. It tells 
+styles how they are expected to be rendered, see ETRenderContext.<br />
+For code written against the previous API, renderContext can also be nil or an 
+NSMutableDictionary, see +[ETRenderContext renderContextWithInputValues:].
 
 ctxt represents the rendering context which encloses the drawing context. For 
 now, the context is nil and must be ignored.  */
-- (void) render: (NSMutableDictionary *)inputValues
+- (void) render: (ETRenderContext *)renderContext
       dirtyRect: (NSRect)dirtyRect 
       inContext: (id)ctxt 
 {
 	ETAssert(supervisorView == nil);
 
+	renderContext = [ETRenderContext renderContextWithInputValues: renderContext];
+
 	//ETLog(@"Render frame %@ of %@ dirtyRect %@ in %@", 
 	//	NSStringFromRect([self drawingFrame]), self, NSStringFromRect(dirtyRect), ctxt);
 
@@ -1628,10 +1707,10 @@ now, the context is nil and must be ignored.  */
 	   content bounds on the paper, but since the supervisor view won't call 
 	   this method when the item is decorated, we can use the same coordinates 
 	   matrix to draw both the foreground and background. */
-	[self renderBackground: inputValues
+	[self renderBackground: renderContext
 	             dirtyRect: dirtyRect
 	             inContext: nil];
-	[self renderForeground: inputValues
+	[self renderForeground: renderContext
 	             dirtyRect: dirtyRect
 	             inContext: nil];
 
@@ -1645,16 +1724,24 @@ The coordinates matrix must be adjusted to the receiver content coordinate space
 before calling this method.
 
 See -render:dirtyRect:inContext: and -contentDrawingBox. */
-- (void) renderBackground: (NSMutableDictionary *)inputValues
+- (void) renderBackground: (ETRenderContext *)renderContext
                 dirtyRect: (NSRect)dirtyRect
                 inContext: (id)ctxt
 {
-	[NSGraphicsContext saveGraphicsState];
-	[[NSBezierPath bezierPathWithRect: dirtyRect] setClip];
-	[_styleGroup render: inputValues
-	         layoutItem: self
-	          dirtyRect: dirtyRect];
-	[NSGraphicsContext restoreGraphicsState];
+	renderContext = [ETRenderContext renderContextWithInputValues: renderContext];
+
+	[renderContext pushRenderState: (ETRenderState){ ETIdentityTransform(), dirtyRect }];
+	if (_recordsDisplayList && [_styleGroup supportsDisplayList])
+	{
+		[self renderStyleGroupWithDisplayList: renderContext dirtyRect: dirtyRect];
+	}
+	else
+	{
+		[_styleGroup render: renderContext
+		         layoutItem: self
+		          dirtyRect: dirtyRect];
+	}
+	[renderContext popRenderState];
 }
 
 /** Draws the foreground style.
@@ -1665,19 +1752,20 @@ The coordinates matrix must be adjusted to the receiver coordinate space, before
 calling this method.
 
 See -render:dirtyRect:inContext: and -drawingBox. */
-- (void) renderForeground: (NSMutableDictionary *)inputValues
+- (void) renderForeground: (ETRenderContext *)renderContext
                 dirtyRect: (NSRect)dirtyRect
                 inContext: (id)ctxt
 {
+	renderContext = [ETRenderContext renderContextWithInputValues: renderContext];
+
 	/* When we have no view, we render the cover style */
-	[NSGraphicsContext saveGraphicsState];
-	[[NSBezierPath bezierPathWithRect: dirtyRect] setClip];
-	[_coverStyle render: inputValues
+	[renderContext pushRenderState: (ETRenderState){ ETIdentityTransform(), dirtyRect }];
+	[_coverStyle render: renderContext
 	         layoutItem: self
 	          dirtyRect: dirtyRect];
 	//[[NSColor yellowColor] set];
 	//NSFrameRectWithWidth(dirtyRect, 4.0);
-	[NSGraphicsContext restoreGraphicsState];
+	[renderContext popRenderState];
 
 	if (showsViewItemMarker)
 	{
@@ -1831,6 +1919,71 @@ If the given style is nil, the style group becomes empty. */
 	[self didChangeValueForProperty: kETCoverStyleProperty];
 }
 
+- (BOOL) recordsDisplayList
+{
+	return _recordsDisplayList;
+}
+
+- (void) setRecordsDisplayList: (BOOL)recordsDisplayList
+{
+	_recordsDisplayList = recordsDisplayList;
+	[self discardDisplayList];
+}
+
+- (ETDisplayList *) displayList
+{
+	return _displayList;
+}
+
+/** Discards the recorded display list, so the next redraw records it again.
+
+The display list is discarded automatically when an item property changes, or 
+when the inputs it was recorded from don't match anymore (see 
+ETDisplayListInputs). You must call this method when the style output depends 
+on some other state, for instance a represented object property whose changes 
+are not reported to the receiver. */
+- (void) discardDisplayList
+{
+	_displayList = nil;
+}
+
+/** Returns the inputs the style group output depends on, in addition to the 
+item properties. */
+- (ETDisplayListInputs) displayListInputsForContext: (ETRenderContext *)renderContext
+{
+	BOOL isFirstResponder = [[[self firstResponderSharingArea] firstResponder] isEqual: self];
+
+	return (ETDisplayListInputs){ [_styleGroup displayListRevision], _contentBounds,
+		[self boundingBox], _flipped, _selected, isFirstResponder,
+		[renderContext drawsSelectionIndicator], [renderContext drawsFirstResponderIndicator] };
+}
+
+/** Renders the style group by replaying the display list if it is still valid, 
+otherwise by recording a new display list. */
+- (void) renderStyleGroupWithDisplayList: (ETRenderContext *)renderContext
+                               dirtyRect: (NSRect)dirtyRect
+{
+	ETDisplayListInputs inputs = [self displayListInputsForContext: renderContext];
+	BOOL isHit = (_displayList != nil && [_displayList isValidForInputs: inputs]);
+
+	ETRecordDisplayListLookup(isHit);
+
+	if (isHit)
+	{
+		[_displayList replay];
+		return;
+	}
+
+	ETDisplayList *recordingDisplayList = [renderContext recordingDisplayList];
+
+	_displayList = [[ETDisplayList alloc] initWithInputs: inputs];
+	[renderContext setRecordingDisplayList: _displayList];
+	[_styleGroup render: renderContext
+	         layoutItem: self
+	          dirtyRect: dirtyRect];
+	[renderContext setRecordingDisplayList: recordingDisplayList];
+}
+
 - (void) setDefaultValue: (id)aValue forProperty: (NSString *)key
 {
 	if (aValue == nil)
@@ -2313,6 +2466,7 @@ Marks the parent item as needing a layout update. */
 	}
 
 	[self updatePersistentGeometryIfNeeded];
+	[[self parentItem] didChangeGeometryOfItem: self];
 	[[self parentItem] setNeedsLayoutUpdate];
 	[self didChangeValueForEmbeddingProperty: kETPositionProperty];
 }
@@ -2506,6 +2660,7 @@ the receiver has no decorator.  */
 
 	[self updatePersistentGeometryIfNeeded];
 	[[self styleGroup] didChangeItemBounds: _contentBounds];
+	[[self parentItem] didChangeGeometryOfItem: self];
 	[self setNeedsLayoutUpdate];
 	if (_decoratorItem == nil)
 	{
@@ -2630,6 +2785,7 @@ The returned rect is expressed in the receiver content coordinate space. */
 
 	_boundingInsetsRect = rectInsets;
 
+	[[self parentItem] didChangeGeometryOfItem: self];
 	[self setNeedsLayoutUpdate];
 	if (_decoratorItem == nil)
 	{
@@ -2917,19 +3073,6 @@ item backed either, returns nil. */
 	return [[NSImage alloc] initWithView: [viewBackedItem displayView] fromRect: rectInView];
 }
 
-- (NSAffineTransform *) boundsTransform
-{
-	NSAffineTransform *transform = [NSAffineTransform transform];
-
-	if ([self isFlipped])
-	{
-		[transform translateXBy: 0.0 yBy: [self height]];
-		[transform scaleXBy: 1.0 yBy: -1.0];
-	}
-
-	return transform;
-}
-
 - (void) drawRect: (NSRect)aRect
 {
 	if ([self supervisorView] != nil)
@@ -2939,13 +3082,12 @@ item backed either, returns nil. */
 	}
 	else
 	{
-		NSAffineTransform *transform = [self boundsTransform];
-		[transform concat];
-
-		[self render: nil dirtyRect: aRect inContext: nil];
+		NSRect bounds = ETMakeRect(NSZeroPoint, [self size]);
+		ETRenderContext *renderContext = [ETRenderContext new];
 
-		[transform invert];
-		[transform concat];
+		[renderContext pushRenderState: ETRenderStateMake(bounds, [self isFlipped], ETNullRect)];
+		[self render: renderContext dirtyRect: aRect inContext: nil];
+		[renderContext popRenderState];
 	}
 }
 
@@ -3340,6 +3482,7 @@ See -[ETResponder focusedItem]. */
     
     [self willChangeValueForProperty: @"hostItem"];
     [self setValue: host forVariableStorageKey: @"hostItem"];
+    [self invalidateOpaqueLayoutForValueChanges];
     [self didChangeValueForProperty: @"hostItem"];
 }
 
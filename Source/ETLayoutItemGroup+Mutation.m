@@ -12,7 +12,9 @@
 #import <EtoileFoundation/NSObject+Model.h>
 #import <EtoileFoundation/Macros.h>
 #import "ETLayoutItemGroup+Mutation.h"
+#import "ETLayoutItem+Private.h"
 #import "ETLayoutItemGroup+Private.h"
+#import "ETLayout.h"
 #import "ETItemTemplate.h"
 #import "ETController.h"
 #import "ETEvent.h"
@@ -46,6 +48,9 @@ layout update.
 
 Also invalidates any item-related caches (e.g. -arrangedItems).
 
+When flag is NO, the tracked insertions and removals are reset (see 
+-insertedItemIndexes).
+
 -reload calls this method to indicate the layout needs to be updated, otherwise 
 the UI won't reflect the latest receiver content. */
 - (void) setHasNewContent: (BOOL)flag
@@ -62,6 +67,148 @@ the UI won't reflect the latest receiver content. */
 		[self willChangeValueForProperty: @"items"];
 		[self didChangeValueForProperty: @"items"];
 	}
+	else
+	{
+		_insertedItemIndexes = nil;
+		_removedItemIndexes = nil;
+		_hasUntrackedContentChanges = NO;
+	}
+}
+
+/** Returns whether the layout can update its presentation of the children with 
+-insertedItemIndexes and -removedItemIndexes.
+
+Sorting, filtering or a new layout change the children order, so the tracked 
+indexes don't match the rows presented by the layout in these cases. */
+- (BOOL) canUpdateLayoutWithContentChanges
+{
+	return (_hasUntrackedContentChanges == NO && _hasNewLayout == NO 
+		&& _hasNewArrangement == NO && _sorted == NO && _filtered == NO);
+}
+
+/** Returns the indexes of the children inserted since the last layout update, 
+expressed in the current children.
+
+Returns nil when the changes since the last layout update cannot be presented 
+with row insertions and removals. For example, when the receiver has been 
+reloaded, sorted or filtered.
+
+A widget layout such as ETTableLayout can remove the rows at 
+-removedItemIndexes, then insert the rows at -insertedItemIndexes, instead of 
+reloading all the rows.
+
+Only the insertions and removals among a receiver using an opaque layout are 
+tracked. */
+- (NSIndexSet *) insertedItemIndexes
+{
+	if ([self canUpdateLayoutWithContentChanges] == NO)
+		return nil;
+
+	return (_insertedItemIndexes != nil ? _insertedItemIndexes : [NSIndexSet indexSet]);
+}
+
+/** Returns the indexes of the children removed since the last layout update, 
+expressed in the children presented by the last layout update.
+
+Returns nil when the changes since the last layout update cannot be presented 
+with row insertions and removals.
+
+See -insertedItemIndexes. */
+- (NSIndexSet *) removedItemIndexes
+{
+	if ([self canUpdateLayoutWithContentChanges] == NO)
+		return nil;
+
+	return (_removedItemIndexes != nil ? _removedItemIndexes : [NSIndexSet indexSet]);
+}
+
+/** Stops tracking the insertions and removals until the next layout update.
+
+The layout will have to reload all the children.
+
+See -insertedItemIndexes. */
+- (void) discardContentChanges
+{
+	_insertedItemIndexes = nil;
+	_removedItemIndexes = nil;
+	_hasUntrackedContentChanges = YES;
+}
+
+- (BOOL) shouldTrackContentChanges
+{
+	return (_hasUntrackedContentChanges == NO && [self isReloading] == NO 
+		&& [[self layout] isOpaque]);
+}
+
+/* Records an insertion at the given index in the current children.
+
+The inserted indexes located after the insertion are shifted. */
+- (void) recordInsertionAtIndex: (NSUInteger)index
+{
+	if ([self shouldTrackContentChanges] == NO)
+	{
+		[self discardContentChanges];
+		return;
+	}
+
+	if (_insertedItemIndexes == nil)
+	{
+		_insertedItemIndexes = [NSMutableIndexSet indexSet];
+	}
+	[_insertedItemIndexes shiftIndexesStartingAtIndex: index by: 1];
+	[_insertedItemIndexes addIndex: index];
+}
+
+/* Records a removal at the given index in the current children.
+
+Removing an item inserted since the last layout update just cancels the 
+insertion. Otherwise the index is converted into an index among the children 
+presented by the last layout update, by skipping the inserted items and the 
+items already removed. */
+- (void) recordRemovalAtIndex: (NSUInteger)index
+{
+	if ([self shouldTrackContentChanges] == NO)
+	{
+		[self discardContentChanges];
+		return;
+	}
+
+	if (_removedItemIndexes == nil)
+	{
+		_removedItemIndexes = [NSMutableIndexSet indexSet];
+	}
+
+	if ([_insertedItemIndexes containsIndex: index])
+	{
+		[_insertedItemIndexes removeIndex: index];
+		[_insertedItemIndexes shiftIndexesStartingAtIndex: index + 1 by: -1];
+		return;
+	}
+
+	NSUInteger oldIndex = index - [_insertedItemIndexes countOfIndexesInRange: NSMakeRange(0, index)];
+
+	for (NSUInteger i = [_removedItemIndexes firstIndex]; i != NSNotFound && i <= oldIndex; 
+	     i = [_removedItemIndexes indexGreaterThanIndex: i])
+	{
+		oldIndex++;
+	}
+
+	[_removedItemIndexes addIndex: oldIndex];
+	[_insertedItemIndexes shiftIndexesStartingAtIndex: index + 1 by: -1];
+}
+
+/* Lets the receiver layout and the opaque layout that presented the removed 
+item discard what they cached for it. */
+- (void) notifyLayoutsOfRemovedItem: (ETLayoutItem *)item
+{
+	ETLayout *layout = [self layout];
+	ETLayout *opaqueLayout = ([layout isOpaque] ? layout : [self opaqueLayoutForValueChanges]);
+
+	if (layout != opaqueLayout)
+	{
+		[layout didRemoveItem: item];
+	}
+	[opaqueLayout didRemoveItem: item];
 }
 
 - (void) didChangeContentWithMoreComing: (BOOL)moreComing
@@ -170,6 +317,7 @@ To do so, -canReload checks -isMutating. */
 
 	[self beginCoalescingModelMutation];
 
+	[self recordInsertionAtIndex: [[self insertionIndexesForIndex: index] firstIndex]];
 	[self attachItems: @[item] atIndexes: INDEXSET(index)];
 	[self didChangeContentWithMoreComing: moreComing];
 
@@ -225,7 +373,7 @@ To do so, -canReload checks -isMutating. */
     if (removalIndex == ETUndeterminedIndex)
     {
         ETAssert(item != nil);
-        removalIndex = [_items indexOfObject: item];
+        removalIndex = [self indexOfItem: item];
         ETAssert(removalIndex != NSNotFound);
     }
     return INDEXSET(removalIndex);
@@ -262,7 +410,9 @@ To do so, -canReload checks -isMutating. */
 
 	[self beginCoalescingModelMutation];
 
+	[self recordRemovalAtIndex: [indexes firstIndex]];
 	[self detachItems: @[item] atIndexes: indexes];
+	[self notifyLayoutsOfRemovedItem: item];
 	[self didChangeContentWithMoreComing: moreComing];
 
 	[self endCoalescingModelMutation];
@@ -21,6 +21,9 @@
 #import "ETLayoutItem+Private.h"
 #import "ETLayoutItem+Scrollable.h"
 #import "ETLayoutExecutor.h"
+#import "ETRenderContext.h"
+#import "ETSelectionModel.h"
+#import "ETSpatialIndex.h"
 #import "EtoileUIProperties.h"
 #import "ETTool.h"
 #import "ETView.h"
@@ -95,6 +98,13 @@ See also -isLayerItem. */
 	return self;
 }
 
+/* The selection model is rebuilt from the children after a deserialization */
+- (void) prepareTransientState
+{
+	[super prepareTransientState];
+	[self discardSelectionModel];
+}
+
 - (void)willDiscard
 {
 	if ([_items isEmpty] == NO && [[ETLayoutExecutor sharedInstance] isEmpty] == NO)
@@ -223,57 +233,52 @@ See also -[NSObject descriptionWithOptions:]. */
 supervisor view.
 
 This method is used by -setExposedItems: to manage view insertion and removal.
+
+Only the views whose exposed state doesn't match the supervisor view are 
+inserted or removed, the other subviews are left untouched.
  
 See also -[ETUItem displayView]. */
 - (void) updateExposedViewsForItems: (NSArray *)items
-                     exposedIndexes: (NSIndexSet *)exposedIndexes
-                   unexposedIndexes: (NSIndexSet *)unexposedIndexes
 {
-	ETAssert(items.count == exposedIndexes.count + unexposedIndexes.count);
-
 	if ([self.layout isOpaque])
 		return;
 
-	NSMutableArray *exposedViews = [NSMutableArray new];
-	NSMutableArray *unexposedViews = [NSMutableArray new];
+	/* The last exposed view in the item order */
+	ETView *viewBelow = nil;
 
-	[items enumerateObjectsUsingBlock:
-		^(ETLayoutItem * _Nonnull item, NSUInteger i, BOOL * _Nonnull stop)
+	/* Item views appear reversed in the supervisor view subviews, so we visit 
+	   the items backwards to know the view above which a view is inserted.
+	   When items contain any layer items, these items come first and are drawn 
+	   last. Their subviews will appear last and be drawn last. */
+	for (ETLayoutItem *item in items.reverseObjectEnumerator)
 	{
 		ETView *view = item.displayView;
-		
+
+		/* When no view backing has been set up */
 		if (view == nil)
-			return;
+			continue;
 
-		if (item.isExposed)
+		BOOL isInserted = (supervisorView != nil && view.superview == supervisorView);
+
+		if (item.isExposed && isInserted == NO)
 		{
-			[exposedViews addObject: view];
+			ETAssert(supervisorView != nil);
+			[supervisorView insertItemView: view aboveItemView: viewBelow];
 		}
-		else
+		else if (item.isExposed == NO && isInserted)
 		{
-			[unexposedViews addObject: view];
+			[supervisorView removeItemView: view];
 		}
-	}];
 
-	ETAssert(exposedViews.isEmpty || exposedIndexes.count == exposedViews.count);
-	ETAssert(unexposedViews.isEmpty || unexposedViews.count == unexposedIndexes.count);
-	
-	/* When no view backing has been set up */
-	if (exposedViews.isEmpty && unexposedViews.isEmpty)
-		return;
-	
-	ETAssert(supervisorView != nil);
-	
-	/* When items contain any layer items, these items come first and are drawn 
-	   last. Their subviews will appear last and be drawn last. */
-	[supervisorView setItemViews: exposedViews];
-
-	/* All unexposed views should have been automatically removed by -setItemViews: */
-	ETAssert([unexposedViews.firstObject superview] == nil);
+		if (item.isExposed)
+		{
+			viewBelow = view;
+		}
+	}
 }
 
 /* We need to create any missing view backing recursively, since creating it in 
--updateExposedViewsForItems:exposedIndexes:unexposedIndexes: won't work reliably 
+-updateExposedViewsForItems: won't work reliably 
 due to layout updates not being executed in a top-down manner, when using 
 -setNeedsLayout rather than -updateLayoutRecursively:. */
 - (void) attachItems: (NSArray *)items atIndexes: (NSIndexSet *)indexes
@@ -289,6 +294,9 @@ due to layout updates not being executed in a top-down manner, when using
 	[self setUpSupervisorViewsForNewItemsIfNeeded: items];
 
 	[_items insertObjects: items atIndexes: indexes hints: @[]];
+	[[items mappedCollection] invalidateOpaqueLayoutForValueChanges];
+	[self invalidateSpatialIndex];
+	[self didAttachItemsToSelectionModel: items];
 }
 
 /** <override-dummy />Adjusts the item tree once the item has become a child of 
@@ -305,7 +313,22 @@ Symetric method to -didDetachItem: */
 
 - (void) detachItems: (NSArray *)items atIndexes: (NSIndexSet *)indexes
 {
+	/* -updateExposedViewsForItems: only visits the receiver items, so the 
+	   detached item views must be removed now */
+	for (ETLayoutItem *item in items)
+	{
+		ETView *view = item.displayView;
+
+		if (view != nil && supervisorView != nil && view.superview == supervisorView)
+		{
+			[supervisorView removeItemView: view];
+		}
+		item.exposed = NO;
+	}
 	[_items removeObjects: items atIndexes: indexes hints: @[]];
+	[[items mappedCollection] invalidateOpaqueLayoutForValueChanges];
+	[self invalidateSpatialIndex];
+	[self didDetachItemsFromSelectionModel: items];
 }
 
 /** <override-dummy />Adjusts the item tree once the item has been removed from 
@@ -320,6 +343,23 @@ Symetric method to -attachItem: */
 
 }
 
+/** Discards the opaque layout cached by the receiver and its descendant items.
+
+The descendant items are only visited when the receiver has a cached opaque 
+layout, since a child item never caches it without its parent. */
+- (void) invalidateOpaqueLayoutForValueChanges
+{
+	if ([self hasCachedOpaqueLayout] == NO)
+		return;
+
+	[super invalidateOpaqueLayoutForValueChanges];
+
+	for (ETLayoutItem *item in _items)
+	{
+		[item invalidateOpaqueLayoutForValueChanges];
+	}
+}
+
 - (BOOL) isCollectionViewpoint: (id)anObject
 {
 	return ([anObject isCollection]
@@ -358,6 +398,7 @@ the mean of ETCollection protocol. */
 	}
 	if ([self usesRepresentedObjectAsProvider])
 	{
+		[self discardContentChanges];
 		[self setHasNewContent: YES];
 	}
 }
@@ -626,10 +667,42 @@ Similar to -lastObject method for collections (see ETCollection).*/
 // conflicts with menu item protocol which also implements this method.
 // Fix compiler.
 
-/** Returns the index of the given child item in the receiver children. */
+/* Renumbers the children to cache their index, see -indexOfItem:. */
+- (void) updateCachedIndexesOfItems
+{
+	NSUInteger index = 0;
+
+	for (ETLayoutItem *item in _items)
+	{
+		[item setCachedIndexInParentItem: index++];
+	}
+}
+
+/** Returns the index of the given child item in the receiver children.
+
+Each child caches its index. When a mutation has made the cached index 
+invalid, all the children are renumbered at once, so the next lookups cost 
+O(1) until the receiver is mutated again. This way, -indexPathFromItem: cost 
+only depends on the item depth in the item tree. */
 - (NSInteger) indexOfItem: (id)item
 {
-	return [_items indexOfObject: item];
+	BOOL isLayoutItem = [item isLayoutItem];
+
+	if (isLayoutItem)
+	{
+		NSUInteger cachedIndex = [(ETLayoutItem *)item cachedIndexInParentItem];
+
+		if (cachedIndex < [_items count] && _items[cachedIndex] == item)
+			return cachedIndex;
+	}
+
+	NSUInteger index = [_items indexOfObject: item];
+
+	if (isLayoutItem && index != NSNotFound)
+	{
+		[self updateCachedIndexesOfItems];
+	}
+	return index;
 }
 
 /** Returns whether the given item is a receiver child or not. */
@@ -833,6 +906,7 @@ You should never use this method unless you write an ETLayoutItem subclass. */
 	[self willChangeValueForProperty: kETLayoutProperty];
 
     _layout = layout;
+    [self invalidateOpaqueLayoutForValueChanges];
     /* We must remove the item views, otherwise they might remain visible as
        subviews (think ETBrowserLayout on GNUstep which has transparent areas),
        because view-based layout won't call -setExposedItems: in -renderWithItems:XXX:. */
@@ -915,6 +989,7 @@ frame (see -usesFlexibleLayoutFrame). */
 		[ETLayoutItem enablesAutolayout];
 	}
 	
+	[self invalidateSpatialIndex];
 	[self setNeedsDisplay: YES];
 	[self setHasNewContent: NO];
 	_hasNewArrangement = NO;
@@ -1009,12 +1084,14 @@ recursively on them.
 The supervisor view or parent item intersects the dirty rect against the 
 receiver drawing box just before calling -render:dirtyRect:inContext:. Which 
 means the dirty rect needs no adjustments. */
-- (void) renderBackground: (NSMutableDictionary *)inputValues
+- (void) renderBackground: (ETRenderContext *)renderContext
                 dirtyRect: (NSRect)dirtyRect
                 inContext: (id)ctxt
 {
 	//ETLog(@"Render %@ dirtyRect %@ in %@", self, NSStringFromRect(dirtyRect), ctxt);
 
+	renderContext = [ETRenderContext renderContextWithInputValues: renderContext];
+
 	if (self.isLayerItem)
 	{
 		//[[NSColor redColor] set];
@@ -1036,14 +1113,26 @@ means the dirty rect needs no adjustments. */
 		   There is no need to set dirtyRect with -[NSBezierPath setClip]
 		   because the right clip rect should have been set by our supervisor
 		   view or our parent item (when when we have no decorator) */
-		[super renderBackground: inputValues dirtyRect: dirtyRect inContext: ctxt];
+		[super renderBackground: renderContext dirtyRect: dirtyRect inContext: ctxt];
 
 		/* Render child items (if the layout doesn't handle it) */
 
-		[NSGraphicsContext saveGraphicsState];
+		/* Clip once for all the children */
+		[renderContext pushRenderState: (ETRenderState){ ETIdentityTransform(), dirtyRect }];
 		if ([[self layout] isOpaque] == NO)
 		{
-			for (ETLayoutItem *item in [self.arrangedItems reverseObjectEnumerator])
+			BOOL drawsSelectionIndicator = [renderContext drawsSelectionIndicator];
+
+			[renderContext setDrawsSelectionIndicator:
+				([[self layout] preventsDrawingItemSelectionIndicator] == NO)];
+
+			/* With a spatial index, we only visit the items that intersect the 
+			   dirty rect, in the same order than -arrangedItems reversed */
+			ETSpatialIndex *spatialIndex = [self spatialIndex];
+			id <NSFastEnumeration> itemsToRender = (spatialIndex != nil ?
+				[spatialIndex itemsIntersectingRect: dirtyRect] : [self.arrangedItems reverseObjectEnumerator]);
+
+			for (ETLayoutItem *item in itemsToRender)
 			{
 				if ([item isVisible] == NO)
 					continue;
@@ -1061,34 +1150,38 @@ means the dirty rect needs no adjustments. */
 				if (NSEqualRects(childDirtyRect, NSZeroRect))
 					continue;
 
-				[self render: inputValues
+				[self render: renderContext
 				        item: item
 				   dirtyRect: childDirtyRect
 				   inContext: ctxt];
 			}
+
+			[renderContext setDrawsSelectionIndicator: drawsSelectionIndicator];
 		}
-		[NSGraphicsContext restoreGraphicsState]; /* Restore the receiver clipping rect */
+		[renderContext popRenderState]; /* Restore the receiver clipping rect */
 	}
 }
 
-- (void) render: (NSMutableDictionary *)inputValues
+- (void) render: (ETRenderContext *)renderContext
       dirtyRect: (NSRect)dirtyRect 
       inContext: (id)ctxt 
 {
 	ETAssert(supervisorView == nil);
 
-	[self renderBackground: inputValues
+	renderContext = [ETRenderContext renderContextWithInputValues: renderContext];
+
+	[self renderBackground: renderContext
 	             dirtyRect: dirtyRect
 	             inContext: nil];
 
 	/* To draw the layout layer, we should adjust the coordinate matrix to the 
 	   content bounds on the paper, but since the supervisor view won't call 
 	   this method when the item is decorated, we don't have to. */
-	[[self.layout layerItem] renderBackground: inputValues
+	[[self.layout layerItem] renderBackground: renderContext
 	                                dirtyRect: dirtyRect
 	                                inContext: ctxt];
 
-	[self renderForeground: inputValues
+	[self renderForeground: renderContext
 	             dirtyRect: dirtyRect
 	             inContext: nil];
 
@@ -1101,13 +1194,16 @@ static BOOL showsDirtyItemRectMarker = NO;
 then calling -render:dirtyRect:inContext: on it, and finally restoring the
 graphic context.
 
-Take note this method doesn't save and restore the graphics state.
+The transform is applied with -[ETRenderContext pushRenderState:], without 
+saving the graphics state per item. The clip is set once per parent in 
+-renderBackground:dirtyRect:inContext:, the item sets its own clip when drawing 
+its styles.
 
 newDirtyRect is expressed in the given item coordinate space and is restricted 
 to the drawing box.
 
 You should never need to call this method directly. */
-- (void) render: (NSMutableDictionary *)inputValues
+- (void) render: (ETRenderContext *)renderContext
            item: (ETLayoutItem *)item
        dirtyRect: (NSRect)newDirtyRect
        inContext: (id)ctxt
@@ -1122,32 +1218,25 @@ You should never need to call this method directly. */
 		[self drawDirectDrawingMarkerForItem: item];
 	}
 	
-	/* Adjust coordinates matrix */
-
-	NSAffineTransform *transform = [NSAffineTransform transform];
+	/* Adjust coordinates matrix and clip */
 
-	[transform translateXBy: [item x] yBy: [item y]];
+	BOOL flipMismatch = ([self isFlipped] != [item isFlipped]); /* != [NSGraphicContext/renderView isFlipped] */
 
-	if ([self isFlipped] != [item isFlipped]) /* != [NSGraphicContext/renderView isFlipped] */
-	{
-		[transform translateXBy: 0.0 yBy: [item height]];
-		[transform scaleXBy: 1.0 yBy: -1.0];
-	}
-	[transform concat];
+	[renderContext pushRenderState:
+		ETRenderStateMake(ETMakeRect([item origin], [item size]), flipMismatch, ETNullRect)];
+	[renderContext setDirtyRect: newDirtyRect];
 	
 	/* Draw the item */
 
-	[[NSBezierPath bezierPathWithRect: newDirtyRect] setClip];
-	[item render: inputValues dirtyRect: newDirtyRect inContext: ctxt];
+	[item render: renderContext dirtyRect: newDirtyRect inContext: ctxt];
 	
 	if (showsDirtyItemRectMarker)
 	{
 		[self drawDirtyRectItemMarkerWithRect: newDirtyRect];
 	}
 
-	/* Reset the coordinates matrix */
-	[transform invert];
-	[transform concat];
+	/* Reset the coordinates matrix and clip */
+	[renderContext popRenderState];
 }
 
 - (void) setCachedDisplayImage: (NSImage *)anImage
@@ -1175,6 +1264,121 @@ You should never need to call this method directly. */
 }
 
 
+/** Returns whether the receiver indexes its child drawing boxes to only visit 
+the children that intersect the dirty rect when rendering.
+
+By default, returns NO.
+
+See -setUsesSpatialIndex:. */
+- (BOOL) usesSpatialIndex
+{
+	return [[self valueForVariableStorageKey: kETUsesSpatialIndexProperty] boolValue];
+}
+
+/** Sets whether the receiver indexes its child drawing boxes to only visit the 
+children that intersect the dirty rect when rendering.
+
+A spatial index makes the redraw cost proportional to the number of redrawn 
+items rather than to the number of children. This is worth using for item 
+groups that contain thousands of children, but only a small area is usually 
+redisplayed (e.g. a canvas with ETFreeLayout).
+
+The index is rebuilt lazily after a layout update or a content mutation, and 
+updated incrementally when a child frame or bounding box changes.
+
+The flag is persisted and copied with the receiver, but the index itself is 
+recreated on demand. */
+- (void) setUsesSpatialIndex: (BOOL)flag
+{
+	if (flag == [self usesSpatialIndex])
+		return;
+
+	[self willChangeValueForProperty: kETUsesSpatialIndexProperty];
+	[self setValue: @(flag) forVariableStorageKey: kETUsesSpatialIndexProperty];
+	_spatialIndex = nil;
+	_needsSpatialIndexRebuild = YES;
+	[self didChangeValueForProperty: kETUsesSpatialIndexProperty];
+}
+
+/** Returns the rect that must be indexed for the given child item.
+
+The returned rect is the child drawing box expressed in the receiver content 
+coordinate space. */
+- (NSRect) spatialIndexRectForItem: (ETLayoutItem *)anItem
+{
+	return [anItem convertRectToParent: [anItem drawingBox]];
+}
+
+- (void) rebuildSpatialIndex
+{
+	NSArray *arrangedItems = [self arrangedItems];
+	NSUInteger nbOfItems = [arrangedItems count];
+
+	[_spatialIndex removeAllItems];
+
+	for (NSUInteger i = 0; i < nbOfItems; i++)
+	{
+		ETLayoutItem *item = arrangedItems[i];
+
+		[_spatialIndex setRect: [self spatialIndexRectForItem: item] 
+		                 order: i
+		               forItem: item];
+	}
+	_needsSpatialIndexRebuild = NO;
+}
+
+/** Returns the spatial index up-to-date with the arranged items, or nil when 
+-usesSpatialIndex returns NO or the layout is rendering. */
+- (ETSpatialIndex *) spatialIndex
+{
+	if ([self usesSpatialIndex] == NO || [_layout isRendering])
+		return nil;
+
+	/* The index is not persisted, so it doesn't exist yet for a copied or 
+	   deserialized item group */
+	if (_spatialIndex == nil)
+	{
+		_spatialIndex = [ETSpatialIndex new];
+		_needsSpatialIndexRebuild = YES;
+	}
+
+	if (_needsSpatialIndexRebuild)
+	{
+		[self rebuildSpatialIndex];
+	}
+	return _spatialIndex;
+}
+
+/** Marks the spatial index to be rebuilt the next time it is accessed.
+
+Must be called when the arranged items change. */
+- (void) invalidateSpatialIndex
+{
+	if (_spatialIndex == nil || _needsSpatialIndexRebuild)
+		return;
+
+	[_spatialIndex removeAllItems];
+	_needsSpatialIndexRebuild = YES;
+}
+
+/** Updates the spatial index entry of the given child item, when its frame or 
+bounding box has changed.
+
+During a layout update, the index is invalidated rather than updated, since 
+every child is usually moved. */
+- (void) didChangeGeometryOfItem: (ETLayoutItem *)anItem
+{
+	if (_spatialIndex == nil || _needsSpatialIndexRebuild)
+		return;
+
+	if ([_layout isRendering])
+	{
+		[self invalidateSpatialIndex];
+		return;
+	}
+	[_spatialIndex setRect: [self spatialIndexRectForItem: anItem] forItem: anItem];
+}
+
 /** Returns the receiver visible child items. */
 - (NSArray *) visibleItems
 {
@@ -1229,33 +1433,32 @@ You shouldn't need to call this method by yourself. */
 	return exposedItems;
 }
 
-/* See -setExposedItems:. */
+/* See -setExposedItems:. 
+
+Only the items whose exposed state changes are touched, the exposed items are 
+looked up in a hash table to keep this method linear in the item count. */
 - (void) setExposedItems: (NSArray *)exposedItems forItems: (NSArray *)items
 {
-	NSMutableIndexSet *exposedIndexes = [NSMutableIndexSet new];
-	NSMutableIndexSet *unexposedIndexes = [NSMutableIndexSet new];
+	NSHashTable *exposedItemSet = [[NSHashTable alloc]
+		initWithOptions: NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+		       capacity: exposedItems.count];
 
-	[items enumerateObjectsUsingBlock:
-		^(ETLayoutItem * _Nonnull item, NSUInteger index, BOOL * _Nonnull stop)
+	for (ETLayoutItem *item in exposedItems)
 	{
-		if ([exposedItems containsObject: item])
-		{
-			item.exposed = YES;
-			[exposedIndexes addIndex: index];
-		}
-		else
-		{
-			item.exposed = NO;
-			[unexposedIndexes addIndex: index];
-		}
-	}];
+		[exposedItemSet addObject: item];
+	}
+
+	for (ETLayoutItem *item in items)
+	{
+		BOOL isExposed = [exposedItemSet containsObject: item];
 
-	/* Views must be attached first, since the indexes are used to insert the
-	   subviews but not to remove them. After the subview insertion, the indexes
-	   are outdated to manipulate the subviews. */
-	[self updateExposedViewsForItems: items
-	                  exposedIndexes: exposedIndexes
-	                unexposedIndexes: unexposedIndexes];
+		if (item.isExposed == isExposed)
+			continue;
+
+		item.exposed = isExposed;
+	}
+
+	[self updateExposedViewsForItems: items];
 }
 
 /* Selection */
@@ -1291,6 +1494,116 @@ Posts an ETItemGroupSelectionDidChangeNotification. */
 	[self setSelectionIndexes: indexes];
 }
 
+/** Returns the receiver selection model, built from the children selection 
+state the first time it is accessed.
+
+Building the selection model also builds the selection model of every 
+descendant item group. Once built, the selection model is kept in sync by 
+-didChangeSelectionStateOfItem: and the mutation callbacks. */
+- (ETSelectionModel *) selectionModel
+{
+	if (_selectionModel != nil)
+		return _selectionModel;
+
+	_selectionModel = [ETSelectionModel new];
+
+	for (ETLayoutItem *item in _items)
+	{
+		[_selectionModel updateItem: item];
+	}
+	return _selectionModel;
+}
+
+/** Discards the selection model of the receiver and its ancestors, to have 
+them rebuilt the next time the selection is accessed.
+
+For an ancestor, the selection model is valid only if the descendant item 
+groups have a valid selection model, that's why the ancestor ones are 
+discarded too. */
+- (void) discardSelectionModel
+{
+	for (ETLayoutItemGroup *item = self; item != nil; item = [item parentItem])
+	{
+		item->_selectionModel = nil;
+	}
+}
+
+/** Returns whether some descendant items are selected in the receiver 
+subtree. */
+- (BOOL) hasSelectedDescendants
+{
+	return ([[self selectionModel] isEmpty] == NO);
+}
+
+/** Updates the selection model when the given child has been selected or 
+deselected, or when its descendant items have been.
+
+When the receiver switches between containing selected descendant items or 
+not, the parent item is told in turn. */
+- (void) didChangeSelectionStateOfItem: (ETLayoutItem *)anItem
+{
+	/* The parent item selection model cannot be valid without the receiver one */
+	if (_selectionModel == nil || [self indexOfItem: anItem] == NSNotFound)
+		return;
+
+	BOOL hadSelectedDescendants = ([_selectionModel isEmpty] == NO);
+
+	[_selectionModel updateItem: anItem];
+
+	if (hadSelectedDescendants == ([_selectionModel isEmpty] == NO))
+		return;
+
+	[[self parentItem] didChangeSelectionStateOfItem: self];
+}
+
+/* Updates the selection model on insertion. */
+- (void) didAttachItemsToSelectionModel: (NSArray *)items
+{
+	for (ETLayoutItem *item in items)
+	{
+		[self didChangeSelectionStateOfItem: item];
+	}
+}
+
+/* Updates the selection model on removal. */
+- (void) didDetachItemsFromSelectionModel: (NSArray *)items
+{
+	if (_selectionModel == nil)
+		return;
+
+	BOOL hadSelectedDescendants = ([_selectionModel isEmpty] == NO);
+
+	for (ETLayoutItem *item in items)
+	{
+		[_selectionModel removeItem: item];
+	}
+
+	if (hadSelectedDescendants == ([_selectionModel isEmpty] == NO))
+		return;
+
+	ETLayoutItemGroup *parentItem = [self parentItem];
+
+	if ([parentItem indexOfItem: self] != NSNotFound)
+	{
+		[parentItem didChangeSelectionStateOfItem: self];
+	}
+}
+
+/* Returns the given children sorted in the receiver children order. */
+- (NSArray *) itemsSortedByIndex: (NSArray *)items
+{
+	return [items sortedArrayUsingComparator: ^ (id item1, id item2)
+	{
+		NSInteger index1 = [self indexOfItem: item1];
+		NSInteger index2 = [self indexOfItem: item2];
+
+		if (index1 == index2)
+			return NSOrderedSame;
+
+		return (index1 < index2 ? NSOrderedAscending : NSOrderedDescending);
+	}];
+}
+
 /** Returns all indexes matching selected items which are immediate children of
 the receiver.
 
@@ -1300,12 +1613,10 @@ length equal one. */
 {
 	NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
 
-	for (NSIndexPath *indexPath in [self selectionIndexPaths])
+	for (ETLayoutItem *item in [[self selectionModel] selectedItems])
 	{
-		if ([indexPath length] == 1)
-			[indexes addIndex: [indexPath firstIndex]];
+		[indexes addIndex: [self indexOfItem: item]];
 	}
-
 	return indexes;
 }
 
@@ -1315,7 +1626,7 @@ any existing selection index paths previously set.
 Posts an ETItemGroupSelectionDidChangeNotification. */
 - (void) setSelectionIndexes: (NSIndexSet *)indexes
 {
-	NSInteger numberOfItems = [[self items] count];
+	NSInteger numberOfItems = [self numberOfItems];
 	NSInteger lastSelectionIndex = [[self selectionIndexes] lastIndex];
 
 	ETDebugLog(@"Set selection indexes to %@ in %@", indexes, self);
@@ -1331,89 +1642,147 @@ Posts an ETItemGroupSelectionDidChangeNotification. */
 	[self setSelectionIndexPaths: [indexes indexPaths] recursively: NO];
 }
 
+/* Only visits the selected children and the child item groups that contain 
+selected descendant items. */
 - (void) collectSelectionIndexPaths: (NSMutableArray *)indexPaths
                      relativeToItem: (ETLayoutItemGroup *)pathBaseItem
 {
-	FOREACHI([self items], item)
+	ETSelectionModel *selectionModel = [self selectionModel];
+
+	for (ETLayoutItem *item in [selectionModel selectedItems])
 	{
-		if ([item isSelected])
-			[indexPaths addObject: [item indexPathFromItem: pathBaseItem]];
+		[indexPaths addObject: [item indexPathFromItem: pathBaseItem]];
+	}
 
-		if ([item isGroup])
-			[item collectSelectionIndexPaths: indexPaths relativeToItem: pathBaseItem];
+	for (ETLayoutItemGroup *item in [selectionModel itemsWithSelectedDescendants])
+	{
+		[item collectSelectionIndexPaths: indexPaths relativeToItem: pathBaseItem];
 	}
 }
 
-
 /** Returns the index paths of selected items in layout item subtree of the the
-receiver. */
+receiver.
+
+The index paths are sorted in the item tree order, a parent item index path 
+comes before its descendant ones. */
 - (NSArray *) selectionIndexPaths
 {
 	NSMutableArray *indexPaths = [NSMutableArray array];
 
 	[self collectSelectionIndexPaths: indexPaths relativeToItem: self];
+	[indexPaths sortUsingSelector: @selector(compare:)];
 
 	return indexPaths;
 }
 
+static inline BOOL ETIsDescendantItem(ETLayoutItem *item, ETLayoutItemGroup *ancestor)
+{
+	for (ETLayoutItemGroup *parent = [item parentItem]; parent != nil; parent = [parent parentItem])
+	{
+		if (parent == ancestor)
+			return YES;
+	}
+	return NO;
+}
+
+/* Collects the selected items in the receiver subtree, or among the receiver 
+children when recursively is NO. */
+- (void) collectSelectedItems: (NSHashTable *)selectedItems 
+                  recursively: (BOOL)recursively
+{
+	ETSelectionModel *selectionModel = [self selectionModel];
+
+	for (ETLayoutItem *item in [selectionModel selectedItems])
+	{
+		[selectedItems addObject: item];
+	}
+
+	if (recursively == NO)
+		return;
+
+	for (ETLayoutItemGroup *item in [selectionModel itemsWithSelectedDescendants])
+	{
+		[item collectSelectedItems: selectedItems recursively: YES];
+	}
+}
+
 /** Selects every descendant items which match the index paths passed in
 parameter and deselects all other descendant items of the receiver.
 
-TODO: This is crude because we deselect everything without taking care of base
-items we encounter during the recursive traversal of the subtree... See
--[ETLayout setSelectionIndexPaths:] to understand the issue more thoroughly.
-Moreover the method is surely extremly slow if called many times within a short
-time interval on a subtree that consists of thousand items or more. */
+When recursively is NO, only the receiver children are selected or deselected.
+
+The index paths are resolved into items, then only the items whose selection 
+state changes are visited, so the cost is proportional to the number of 
+selected items before and after the change.
+
+For each item group whose children selection changes, the KVO notifications 
+for <em>selectedItems</em> and <em>selectedItemsInLayout</em>, and 
+ETItemGroupSelectionDidChangeNotification are posted once. */
 - (BOOL) applySelectionIndexPaths: (NSMutableArray *)indexPaths
                    relativeToItem: (ETLayoutItemGroup *)baseItem
                       recursively: (BOOL)recursively
 {
-	BOOL changedSelection = NO;
-	BOOL emittedWillChangeSelection = NO;
+	NSHashTable *oldSelectedItems = [NSHashTable hashTableWithOptions: NSPointerFunctionsObjectPointerPersonality];
+	NSHashTable *newSelectedItems = [NSHashTable hashTableWithOptions: NSPointerFunctionsObjectPointerPersonality];
 
-	FOREACHI([self items], item)
+	[self collectSelectedItems: oldSelectedItems recursively: recursively];
+
+	for (NSIndexPath *indexPath in indexPaths)
 	{
-		NSIndexPath *itemIndexPath = [item indexPathFromItem: baseItem];
-		BOOL select = [indexPaths containsObject: itemIndexPath];
-		
-		/* Post notifications on deselection too */
-		if (select != [item isSelected] && emittedWillChangeSelection == NO)
-		{
-			emittedWillChangeSelection = YES;
-			// TODO: Perhaps post the same for selectionIndex, selectionIndexes
-			// and selectionIndexPaths
-			// TODO: Would be better to use -will/DidChangeValueForProperty:
-			[self willChangeValueForKey: @"selectedItems"];
-			[self willChangeValueForKey: @"selectedItemsInLayout"];
-		}
+		ETLayoutItem *item = [baseItem itemAtIndexPath: indexPath];
+		BOOL isInScope = (recursively ? ETIsDescendantItem(item, self) : [item parentItem] == self);
 
-		if (select)
-		{
-			[item setSelected: YES];
-			[indexPaths removeObject: itemIndexPath];
-		}
-		else
-		{
-			[item setSelected: NO];
-		}
-		
-		if ([item isGroup] && recursively)
-		{
-			changedSelection = changedSelection | [item applySelectionIndexPaths: indexPaths
-			                                                      relativeToItem: baseItem
-			                                                         recursively: recursively];
-		}
+		if (item == nil || isInScope == NO || [item isSelectable] == NO)
+			continue;
 
-		if (emittedWillChangeSelection)
-		{
-			[self didChangeValueForKey: @"selectedItems"];
-			[self didChangeValueForKey: @"selectedItemsInLayout"];
-			[self didChangeSelection];
-			changedSelection = YES;
-		}
+		[newSelectedItems addObject: item];
+	}
+
+	NSMutableArray *changedItems = [NSMutableArray array];
+
+	for (ETLayoutItem *item in oldSelectedItems)
+	{
+		if ([newSelectedItems containsObject: item] == NO)
+			[changedItems addObject: item];
+	}
+	for (ETLayoutItem *item in newSelectedItems)
+	{
+		if ([oldSelectedItems containsObject: item] == NO)
+			[changedItems addObject: item];
+	}
+
+	if ([changedItems isEmpty])
+		return NO;
+
+	NSMutableOrderedSet *changedGroups = [NSMutableOrderedSet orderedSet];
+
+	for (ETLayoutItem *item in changedItems)
+	{
+		[changedGroups addObject: [item parentItem]];
+	}
+
+	for (ETLayoutItemGroup *itemGroup in changedGroups)
+	{
+		// TODO: Perhaps post the same for selectionIndex, selectionIndexes
+		// and selectionIndexPaths
+		// TODO: Would be better to use -will/DidChangeValueForProperty:
+		[itemGroup willChangeValueForKey: @"selectedItems"];
+		[itemGroup willChangeValueForKey: @"selectedItemsInLayout"];
+	}
+
+	for (ETLayoutItem *item in changedItems)
+	{
+		[item setSelected: [newSelectedItems containsObject: item]];
+	}
+
+	for (ETLayoutItemGroup *itemGroup in changedGroups)
+	{
+		[itemGroup didChangeValueForKey: @"selectedItems"];
+		[itemGroup didChangeValueForKey: @"selectedItemsInLayout"];
+		[itemGroup didChangeSelection];
 	}
 
-	return changedSelection;
+	return YES;
 }
 
 /** Returns YES when a selection change initiated by -setSelectionIndex:,
@@ -1554,8 +1923,7 @@ The returned collection only includes immediate children, other selected
 descendant items below these childrens in the layout item subtree are excluded. */
 - (NSArray *) selectedItems
 {
-	return [[self items] objectsMatchingValue: @YES
-	                                   forKey: @"isSelected"];
+	return [self itemsSortedByIndex: [[self selectionModel] selectedItems]];
 }
 
 /** Returns selected descendant items reported by the active layout through
@@ -1586,6 +1954,69 @@ redisplayed. */
 	[self setSelectionIndexPaths: (id)[[items mappedCollection] indexPathFromItem: self]];
 }
 
+/** Adds the given children to the selection, and keeps the children already 
+selected.
+
+The selection is updated in a single pass, so an 
+ETItemGroupSelectionDidChangeNotification is posted once, and the layout is 
+told about the change once with -[ETLayout selectionDidChangeInLayoutContext:].
+
+Items that are not receiver children or not selectable are ignored. */
+- (void) selectItems: (NSArray *)items
+{
+	NSMutableIndexSet *indexes = [[self selectionIndexes] mutableCopy];
+
+	for (ETLayoutItem *item in items)
+	{
+		if ([item isSelectable] == NO)
+			continue;
+
+		NSUInteger index = [self indexOfItem: item];
+
+		if (index != NSNotFound)
+		{
+			[indexes addIndex: index];
+		}
+	}
+	[self setSelectionIndexes: indexes];
+}
+
+/** Removes the given children from the selection, and keeps the other 
+children selected.
+
+The selection is updated in a single pass, like -selectItems: does.
+
+Items that are not receiver children are ignored. */
+- (void) deselectItems: (NSArray *)items
+{
+	NSMutableIndexSet *indexes = [[self selectionIndexes] mutableCopy];
+
+	for (ETLayoutItem *item in items)
+	{
+		NSUInteger index = [self indexOfItem: item];
+
+		if (index != NSNotFound)
+		{
+			[indexes removeIndex: index];
+		}
+	}
+	[self setSelectionIndexes: indexes];
+}
+
+/** Deselects all the receiver children in a single pass.
+
+Posts an ETItemGroupSelectionDidChangeNotification once, if some children were 
+selected.
+
+See also -selectItems:. */
+- (void) deselectAll
+{
+	if ([[[self selectionModel] selectedItems] isEmpty])
+		return;
+
+	[self setSelectionIndexes: [NSIndexSet indexSet]];
+}
+
 /* Sorting and Filtering */
 
 - (void) sortWithSortDescriptors: (NSArray *)sortDescriptors recursively: (BOOL)recursively
@@ -1608,6 +2039,7 @@ redisplayed. */
 		_sorted = YES;
 		_filtered = NO;
 		_hasNewArrangement = YES;
+		[self invalidateSpatialIndex];
 	}
 	else
 	{
@@ -1617,6 +2049,7 @@ redisplayed. */
 		_sorted = NO;
 		_filtered = NO;
 		_hasNewArrangement = YES;
+		[self invalidateSpatialIndex];
 	}
 
 	if (recursively)
@@ -1688,6 +2121,7 @@ redisplayed. */
 		                                ignoringItems: itemsWithMatchingDescendants];
 		_filtered = YES;
 		_hasNewArrangement = YES;
+		[self invalidateSpatialIndex];
 	}
 	else
 	{
@@ -1696,6 +2130,7 @@ redisplayed. */
 		_arrangedItems = itemsToFilter;
 		_filtered = NO;
 		_hasNewArrangement = YES;
+		[self invalidateSpatialIndex];
 	}
 }
 
@@ -1721,14 +2156,45 @@ otherwise returns an array identical to -items.
 If the receiver has not been sorted or filtered yet, returns a nil array. */
 - (NSArray *) arrangedItems
 {
-	if (_sorted || _filtered)
-	{
-		return [_arrangedItems copy];
-	}
-	else
-	{
-		return [_items copy];
-	}
+	return [[self arrangedItemsNoCopy] copy];
+}
+
+/* Returns the array backing -arrangedItems without a defensive copy.
+
+The returned array must not be retained, since it can be mutated or replaced 
+on the next mutation, sorting or filtering. */
+- (NSArray *) arrangedItemsNoCopy
+{
+	return (_sorted || _filtered ? _arrangedItems : _items);
+}
+
+/** Returns the number of items in -arrangedItems.
+
+Unlike <code>[[self arrangedItems] count]</code>, doesn't copy the arranged 
+items. */
+- (NSUInteger) numberOfArrangedItems
+{
+	return [[self arrangedItemsNoCopy] count];
+}
+
+/** Returns the item at the given index in -arrangedItems.
+
+Unlike <code>[self arrangedItems][index]</code>, doesn't copy the arranged 
+items, so widget layouts can call it for each visible row or cell.
+
+Raises an NSRangeException if the index is beyond -numberOfArrangedItems. */
+- (ETLayoutItem *) arrangedItemAtIndex: (NSUInteger)index
+{
+	return [self arrangedItemsNoCopy][index];
+}
+
+/** Returns the index of the given item in -arrangedItems, or NSNotFound.
+
+Unlike <code>[[self arrangedItems] indexOfObject: anItem]</code>, doesn't copy 
+the arranged items. */
+- (NSUInteger) indexOfArrangedItem: (ETLayoutItem *)anItem
+{
+	return [[self arrangedItemsNoCopy] indexOfObjectIdenticalTo: anItem];
 }
 
 /* Actions */
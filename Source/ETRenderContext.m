@@ -0,0 +1,219 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <EtoileFoundation/Macros.h>
+#import "ETRenderContext.h"
+#import "ETGeometry.h"
+#import "ETCompatibility.h"
+#include <stdlib.h>
+
+@implementation ETRenderContext
+
+@synthesize dirtyRect = _dirtyRect, transform = _transform, clipRect = _clipRect;
+@synthesize drawsSelectionIndicator = _drawsSelectionIndicator;
+@synthesize drawsFirstResponderIndicator = _drawsFirstResponderIndicator;
+@synthesize scaleFactor = _scaleFactor;
+@synthesize recordingDisplayList = _recordingDisplayList;
+
+/** Returns the given input values when they are a render context, otherwise a
+new render context that wraps the given dictionary as its -inputValues.
+
+A mutable dictionary is not copied, so the values set while rendering remain 
+visible to the caller, as they were when the dictionary was passed directly. 
+An immutable dictionary is copied.
+
+When inputValues is nil, returns a new render context. */
++ (ETRenderContext *) renderContextWithInputValues: (NSDictionary *)inputValues
+{
+	if ([inputValues isKindOfClass: self])
+		return (ETRenderContext *)inputValues;
+
+	ETRenderContext *renderContext = [self new];
+
+	if ([inputValues isKindOfClass: [NSMutableDictionary class]])
+	{
+		renderContext->_inputValues = (NSMutableDictionary *)inputValues;
+	}
+	else if (inputValues != nil)
+	{
+		renderContext->_inputValues = [inputValues mutableCopy];
+	}
+	return renderContext;
+}
+
+- (instancetype) init
+{
+	SUPERINIT;
+	_transform = ETIdentityTransform();
+	_clipRect = ETNullRect;
+	_dirtyRect = ETNullRect;
+	_drawsSelectionIndicator = YES;
+	_drawsFirstResponderIndicator = YES;
+	_scaleFactor = 1;
+	return self;
+}
+
+- (void) dealloc
+{
+	free(_stateStack);
+}
+
+/** Resets the state set while rendering the previous frame, and replaces the 
+input values with the given ones.
+
+The rendering state, the drawing options and the recording display list are 
+reset to their initial values. The scale factor is left untouched.
+
+Must be called before rendering a new frame, and never while rendering. */
+- (void) resetWithInputValues: (NSDictionary *)inputValues
+{
+	ETAssert(_stateCount == 0);
+
+	_transform = ETIdentityTransform();
+	_clipRect = ETNullRect;
+	_dirtyRect = ETNullRect;
+	_drawsSelectionIndicator = YES;
+	_drawsFirstResponderIndicator = YES;
+	_recordingDisplayList = nil;
+
+	if ([inputValues count] > 0)
+	{
+		[[self inputValues] setDictionary: inputValues];
+	}
+	else
+	{
+		[_inputValues removeAllObjects];
+	}
+}
+
+#pragma mark Rendering State -
+
+/** Saves the current render context state, then concatenates the given
+transform to -transform and converts the current clip rect and dirty rect to 
+the new coordinate space.
+
+When the given clip rect is not ETNullRect, the clip rect becomes the 
+intersection of the converted clip rect and the given one, and the dirty rect 
+becomes the resulting clip rect.
+
+The current graphics context is adjusted with ETPushRenderState().
+
+Must be balanced with -popRenderState. */
+- (void) pushRenderState: (ETRenderState)aState
+{
+	if (_stateCount == _stateCapacity)
+	{
+		_stateCapacity = MAX(16, _stateCapacity * 2);
+		_stateStack = realloc(_stateStack, _stateCapacity * sizeof(ETRenderContextState));
+	}
+	_stateStack[_stateCount++] = (ETRenderContextState){ aState, _transform, _clipRect, _dirtyRect };
+
+	_transform = ETConcatenatedTransform(aState.transform, _transform);
+	_clipRect = ETRectInTransformedSpace(_clipRect, aState.transform);
+
+	if (ETIsNullRect(aState.clipRect))
+	{
+		_dirtyRect = ETRectInTransformedSpace(_dirtyRect, aState.transform);
+	}
+	else
+	{
+		_clipRect = (ETIsNullRect(_clipRect) ? aState.clipRect : NSIntersectionRect(_clipRect, aState.clipRect));
+		_dirtyRect = _clipRect;
+	}
+
+	ETPushRenderState(aState);
+}
+
+/** Restores the render context state and the graphics context, as they were
+before the last -pushRenderState:. */
+- (void) popRenderState
+{
+	ETAssert(_stateCount > 0);
+	ETRenderContextState state = _stateStack[--_stateCount];
+
+	_transform = state.transform;
+	_clipRect = state.clipRect;
+	_dirtyRect = state.dirtyRect;
+
+	ETPopRenderState(state.renderState);
+}
+
+#pragma mark Recording Display Lists -
+
+/** Executes the given drawing command, and records it in
+-recordingDisplayList if there is one.
+
+Styles that return YES to -[ETStyle supportsDisplayList] must draw through
+this method with ETDraw(), and compute their geometry outside of the command,
+so replaying the command skips the computation.
+
+The command is copied only when recorded, so drawing without a display list
+doesn't allocate. */
+- (void) draw: (ETDrawingCommand)aCommand
+{
+	if (_recordingDisplayList != nil)
+	{
+		[_recordingDisplayList addCommand: aCommand];
+	}
+	aCommand();
+}
+
+#pragma mark Input Values -
+
+- (NSMutableDictionary *) inputValues
+{
+	if (_inputValues == nil)
+	{
+		_inputValues = [NSMutableDictionary new];
+	}
+	return _inputValues;
+}
+
+- (id) objectForKey: (id)aKey
+{
+	return [_inputValues objectForKey: aKey];
+}
+
+- (void) setObject: (id)anObject forKey: (id <NSCopying>)aKey
+{
+	[[self inputValues] setObject: anObject forKey: aKey];
+}
+
+- (void) removeObjectForKey: (id)aKey
+{
+	[_inputValues removeObjectForKey: aKey];
+}
+
+- (id) objectForKeyedSubscript: (id)aKey
+{
+	return [self objectForKey: aKey];
+}
+
+- (void) setObject: (id)anObject forKeyedSubscript: (id <NSCopying>)aKey
+{
+	[self setObject: anObject forKey: aKey];
+}
+
+- (NSUInteger) count
+{
+	return [_inputValues count];
+}
+
+- (NSEnumerator *) keyEnumerator
+{
+	return [[self inputValues] keyEnumerator];
+}
+
+- (NSUInteger) countByEnumeratingWithState: (NSFastEnumerationState *)state 
+                                   objects: (__unsafe_unretained id [])objects 
+                                     count: (NSUInteger)count
+{
+	return [[self inputValues] countByEnumeratingWithState: state objects: objects count: count];
+}
+
+@end
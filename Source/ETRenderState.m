@@ -0,0 +1,180 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import "ETRenderState.h"
+#ifdef GNUSTEP
+#import <Foundation/NSDebug.h>
+#import <AppKit/NSBezierPath.h>
+#import <AppKit/PSOperators.h>
+#endif
+#import "ETCompatibility.h"
+
+static ETRenderStatistics renderStatistics = { 0, 0, 0, 0 };
+/* The graphics allocations counted when the statistics were reset */
+static NSUInteger initialAllocationTotal = 0;
+
+/* Returns the number of NSAffineTransform and NSBezierPath instances allocated 
+since the allocation debugging was activated, or NSNotFound when the 
+allocations cannot be measured. */
+static NSUInteger GraphicsAllocationTotal(void)
+{
+#ifdef GNUSTEP
+	return GSDebugAllocationTotal([NSAffineTransform class])
+		+ GSDebugAllocationTotal([NSBezierPath class]);
+#else
+	return NSNotFound;
+#endif
+}
+
+/* Concatenates the given transform to the current coordinates matrix with the 
+graphics backend functions. */
+static void ETConcatTransform(NSGraphicsContext *ctxt, NSAffineTransformStruct t)
+{
+#ifdef GNUSTEP
+	CGFloat matrix[6] = { t.m11, t.m12, t.m21, t.m22, t.tX, t.tY };
+	PSconcat(matrix);
+#else
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+	CGContextConcatCTM((CGContextRef)[ctxt graphicsPort],
+		CGAffineTransformMake(t.m11, t.m12, t.m21, t.m22, t.tX, t.tY));
+#pragma clang diagnostic pop
+#endif
+}
+
+/* Returns whether the graphics state must be saved to undo the render state. 
+
+A clip can only be undone by restoring the graphics state, and a transform 
+that cannot be inverted too. */
+static inline BOOL ETRenderStateNeedsSave(ETRenderState state)
+{
+	return (ETIsNullRect(state.clipRect) == NO || ETIsInvertibleTransform(state.transform) == NO);
+}
+
+/** Concatenates the render state transform to the current coordinates matrix 
+and intersects the current clip with the render state clip rect.
+
+Must be balanced with ETPopRenderState() and the same render state.
+
+The graphics state is saved only when the render state has a clip rect. 
+Otherwise the transform is undone by ETPopRenderState() with the inverse 
+transform. */
+void ETPushRenderState(ETRenderState state)
+{
+	NSGraphicsContext *ctxt = [NSGraphicsContext currentContext];
+
+	if (ETRenderStateNeedsSave(state))
+	{
+		[ctxt saveGraphicsState];
+	}
+	ETConcatTransform(ctxt, state.transform);
+
+	if (ETIsNullRect(state.clipRect) == NO)
+	{
+		NSRectClip(state.clipRect);
+	}
+	renderStatistics.renderStateCount++;
+}
+
+/** Restores the transform and clip that were current before 
+ETPushRenderState() was called with the given render state. */
+void ETPopRenderState(ETRenderState state)
+{
+	NSGraphicsContext *ctxt = [NSGraphicsContext currentContext];
+
+	if (ETRenderStateNeedsSave(state))
+	{
+		[ctxt restoreGraphicsState];
+	}
+	else
+	{
+		ETConcatTransform(ctxt, ETInvertedTransform(state.transform));
+	}
+}
+
+/** Returns the given rect expressed in the coordinate space obtained by
+applying the given transform.
+
+When the transform rotates or skews the coordinate space, returns the bounding
+box of the transformed rect. When the transform cannot be inverted, returns
+ETNullRect. */
+NSRect ETRectInTransformedSpace(NSRect aRect, NSAffineTransformStruct t)
+{
+	if (ETIsNullRect(aRect))
+		return ETNullRect;
+
+	if (ETIsInvertibleTransform(t) == NO)
+		return ETNullRect;
+
+	NSAffineTransformStruct inverse = ETInvertedTransform(t);
+
+	NSPoint corners[4] = { { NSMinX(aRect), NSMinY(aRect) }, { NSMaxX(aRect), NSMinY(aRect) },
+	                       { NSMinX(aRect), NSMaxY(aRect) }, { NSMaxX(aRect), NSMaxY(aRect) } };
+	CGFloat minX = CGFLOAT_MAX, minY = CGFLOAT_MAX, maxX = -CGFLOAT_MAX, maxY = -CGFLOAT_MAX;
+
+	for (int i = 0; i < 4; i++)
+	{
+		CGFloat x = corners[i].x * inverse.m11 + corners[i].y * inverse.m21 + inverse.tX;
+		CGFloat y = corners[i].x * inverse.m12 + corners[i].y * inverse.m22 + inverse.tY;
+
+		minX = MIN(minX, x);
+		minY = MIN(minY, y);
+		maxX = MAX(maxX, x);
+		maxY = MAX(maxY, y);
+	}
+	return NSMakeRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+/** Returns the statistics collected since the last ETResetRenderStatistics().
+
+For example, to count the allocations per frame:
+
+<example>
+ETResetRenderStatistics();
+[itemGroup display];
+ETLog(@"Allocations per frame %lu", ETGetRenderStatistics().allocationCount);
+</example> */
+ETRenderStatistics ETGetRenderStatistics(void)
+{
+	ETRenderStatistics statistics = renderStatistics;
+	NSUInteger allocationTotal = GraphicsAllocationTotal();
+
+	statistics.allocationCount = (allocationTotal != NSNotFound ?
+		allocationTotal - initialAllocationTotal : NSNotFound);
+	return statistics;
+}
+
+/** Resets the render statistics to zero.
+
+On GNUstep, the first call activates the allocation debugging with 
+GSDebugAllocationActive(), which slows down every allocation in the process. 
+So this function should only be called by benchmarks and tests. */
+void ETResetRenderStatistics(void)
+{
+#ifdef GNUSTEP
+	GSDebugAllocationActive(YES);
+#endif
+	renderStatistics = (ETRenderStatistics){ 0, 0, 0, 0 };
+	initialAllocationTotal = GraphicsAllocationTotal();
+}
+
+/** Records whether an item rendering replayed its display list, or had to
+record it.
+
+See -[ETLayoutItem recordsDisplayList]. */
+void ETRecordDisplayListLookup(BOOL isHit)
+{
+	if (isHit)
+	{
+		renderStatistics.displayListHitCount++;
+	}
+	else
+	{
+		renderStatistics.displayListMissCount++;
+	}
+}
@@ -8,6 +8,7 @@
 
 #import <EtoileFoundation/Macros.h>
 #import "ETScrollableAreaItem.h"
+#import "ETComputedLayout.h"
 #import "ETView.h"
 #import "ETGeometry.h"
 #import "ETLayoutItemGroup.h"
@@ -87,6 +88,14 @@ into a scrollable area. */
 	                                         selector: @selector(clipViewFrameDidChange:)
 	                                             name: NSViewFrameDidChangeNotification
 	                                           object: [self supervisorView]];
+
+	NSClipView *clipView = [[self scrollView] contentView];
+
+	[clipView setPostsBoundsChangedNotifications: YES];
+	[[NSNotificationCenter defaultCenter] addObserver: self
+	                                         selector: @selector(clipViewBoundsDidChange:)
+	                                             name: NSViewBoundsDidChangeNotification
+	                                           object: clipView];
 }
 
 - (instancetype) initWithScrollView: (NSScrollView *)aScrollView
@@ -156,6 +165,26 @@ usually through its enclosing scroll view getting resized. */
 	}
 }
 
+/** Lets the decorated item layout expose the items scrolled into the visible 
+area, when the layout virtualizes its items.
+
+See -[ETComputedLayout virtualizesItems]. */
+- (void) clipViewBoundsDidChange: (NSNotification *)notif
+{
+	ETUIItem *decoratedItem = [self decoratedItem];
+
+	if ([decoratedItem isLayoutItem] == NO || [decoratedItem isGroup] == NO)
+		return;
+
+	ETLayout *layout = [(ETLayoutItemGroup *)decoratedItem layout];
+	id positionalLayout = [layout positionalLayout];
+
+	if ([positionalLayout isComputedLayout] == NO)
+		return;
+
+	[(ETComputedLayout *)positionalLayout updateExposedItems];
+}
+
 - (void) saveAndOverrideAutoresizingMaskOfDecoratedItem: (ETUIItem *)item
 {
 #ifdef GNUSTEP /* Required with GNUstep prior to trunk r28465 */
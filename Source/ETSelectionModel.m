@@ -0,0 +1,88 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <EtoileFoundation/Macros.h>
+#import "ETSelectionModel.h"
+#import "ETLayoutItem.h"
+#import "ETLayoutItemGroup.h"
+#import "ETLayoutItemGroup+Private.h"
+#import "ETCompatibility.h"
+
+@implementation ETSelectionModel
+
+- (instancetype) init
+{
+	SUPERINIT;
+	_selectedItems = [NSHashTable hashTableWithOptions: NSPointerFunctionsObjectPointerPersonality];
+	_itemsWithSelectedDescendants = [NSHashTable hashTableWithOptions: NSPointerFunctionsObjectPointerPersonality];
+	return self;
+}
+
+- (NSString *) description
+{
+	return [NSString stringWithFormat: @"%@ selectedItems %lu itemsWithSelectedDescendants %lu",
+		[super description], (unsigned long)[_selectedItems count],
+		(unsigned long)[_itemsWithSelectedDescendants count]];
+}
+
+/** Updates the selection state recorded for the given child.
+
+The child is looked up as a selected item with -[ETLayoutItem isSelected], and
+as an item group containing selected descendant items with
+-[ETLayoutItemGroup hasSelectedDescendants]. */
+- (void) updateItem: (ETLayoutItem *)anItem
+{
+	if ([anItem isSelected])
+	{
+		[_selectedItems addObject: anItem];
+	}
+	else
+	{
+		[_selectedItems removeObject: anItem];
+	}
+
+	if ([anItem isGroup] && [(ETLayoutItemGroup *)anItem hasSelectedDescendants])
+	{
+		[_itemsWithSelectedDescendants addObject: anItem];
+	}
+	else
+	{
+		[_itemsWithSelectedDescendants removeObject: anItem];
+	}
+}
+
+/** Discards the selection state recorded for the given child, when it is
+removed from the item group. */
+- (void) removeItem: (ETLayoutItem *)anItem
+{
+	[_selectedItems removeObject: anItem];
+	[_itemsWithSelectedDescendants removeObject: anItem];
+}
+
+- (BOOL) isEmpty
+{
+	return ([_selectedItems count] == 0 && [_itemsWithSelectedDescendants count] == 0);
+}
+
+- (NSArray *) selectedItems
+{
+	return [_selectedItems allObjects];
+}
+
+- (NSArray *) itemsWithSelectedDescendants
+{
+	return [_itemsWithSelectedDescendants allObjects];
+}
+
+/** Returns whether the given child is selected. */
+- (BOOL) isSelectedItem: (ETLayoutItem *)anItem
+{
+	return [_selectedItems containsObject: anItem];
+}
+
+@end
@@ -0,0 +1,323 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <EtoileFoundation/Macros.h>
+#import "ETSpatialIndex.h"
+#import "ETGeometry.h"
+#import "ETLayoutItem.h"
+#import "ETCompatibility.h"
+
+/* An item location in the grid */
+@interface ETSpatialIndexEntry : NSObject
+{
+	@public
+	ETLayoutItem *item;
+	NSRect rect;
+	NSUInteger order;
+	NSInteger minColumn, maxColumn, minRow, maxRow;
+	BOOL isOverflow;
+	NSUInteger queryStamp;
+}
+@end
+
+@implementation ETSpatialIndexEntry
+@end
+
+
+@implementation ETSpatialIndex
+
+@synthesize cellSize = _cellSize;
+
+- (instancetype) initWithCellSize: (NSSize)aSize
+{
+	NSParameterAssert(aSize.width > 0 && aSize.height > 0);
+	SUPERINIT;
+	_cellSize = aSize;
+	_cells = [NSMutableDictionary new];
+	_entries = [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsObjectPointerPersonality
+	                                 valueOptions: NSPointerFunctionsStrongMemory];
+	_overflowEntries = [NSMutableSet new];
+	return self;
+}
+
+- (instancetype) init
+{
+	return [self initWithCellSize: NSMakeSize(256, 256)];
+}
+
+- (NSString *) description
+{
+	return [NSString stringWithFormat: @"%@ cellSize %@ count %lu", [super description],
+		NSStringFromSize(_cellSize), (unsigned long)[self count]];
+}
+
+static inline NSNumber *ETCellKey(NSInteger column, NSInteger row)
+{
+	return [NSNumber numberWithLongLong: ((long long)column << 32) | (uint32_t)row];
+}
+
+/* Beyond this number of covered cells, an entry is kept in the overflow 
+entries rather than in the grid. */
+static const double ETSpatialIndexMaxCellsPerEntry = 1024;
+
+static inline BOOL ETIsFiniteRect(NSRect rect)
+{
+	return (isfinite(NSMinX(rect)) && isfinite(NSMinY(rect))
+		&& isfinite(NSWidth(rect)) && isfinite(NSHeight(rect)));
+}
+
+static inline BOOL ETIsValidCellIndex(double index)
+{
+	return (index >= INT32_MIN && index <= INT32_MAX);
+}
+
+/* Returns the number of cells covered by the rect, or HUGE_VAL when the rect 
+is not finite or lies outside the cell indexes that ETCellKey() can encode. 
+The cell range is computed in floating point, so it cannot overflow. */
+static inline double ETCoveredCellRange(NSRect rect, NSSize cellSize, 
+	double *minColumn, double *maxColumn, double *minRow, double *maxRow)
+{
+	if (ETIsFiniteRect(rect) == NO)
+		return HUGE_VAL;
+
+	*minColumn = floor(NSMinX(rect) / cellSize.width);
+	*maxColumn = floor(NSMaxX(rect) / cellSize.width);
+	*minRow = floor(NSMinY(rect) / cellSize.height);
+	*maxRow = floor(NSMaxY(rect) / cellSize.height);
+
+	if (ETIsValidCellIndex(*minColumn) == NO || ETIsValidCellIndex(*maxColumn) == NO
+	 || ETIsValidCellIndex(*minRow) == NO || ETIsValidCellIndex(*maxRow) == NO)
+	{
+		return HUGE_VAL;
+	}
+	return (*maxColumn - *minColumn + 1) * (*maxRow - *minRow + 1);
+}
+
+- (void) computeCellRangeForEntry: (ETSpatialIndexEntry *)entry
+{
+	double minColumn, maxColumn, minRow, maxRow;
+	double nbOfCoveredCells = ETCoveredCellRange(entry->rect, _cellSize,
+		&minColumn, &maxColumn, &minRow, &maxRow);
+
+	entry->isOverflow = (nbOfCoveredCells > ETSpatialIndexMaxCellsPerEntry);
+
+	if (entry->isOverflow)
+		return;
+
+	entry->minColumn = minColumn;
+	entry->maxColumn = maxColumn;
+	entry->minRow = minRow;
+	entry->maxRow = maxRow;
+}
+
+- (void) insertEntryIntoCells: (ETSpatialIndexEntry *)entry
+{
+	if (entry->isOverflow)
+	{
+		[_overflowEntries addObject: entry];
+		return;
+	}
+
+	for (NSInteger column = entry->minColumn; column <= entry->maxColumn; column++)
+	{
+		for (NSInteger row = entry->minRow; row <= entry->maxRow; row++)
+		{
+			NSNumber *key = ETCellKey(column, row);
+			NSMutableSet *cell = _cells[key];
+
+			if (cell == nil)
+			{
+				cell = [NSMutableSet set];
+				_cells[key] = cell;
+			}
+			[cell addObject: entry];
+		}
+	}
+}
+
+- (void) removeEntryFromCells: (ETSpatialIndexEntry *)entry
+{
+	if (entry->isOverflow)
+	{
+		[_overflowEntries removeObject: entry];
+		return;
+	}
+
+	for (NSInteger column = entry->minColumn; column <= entry->maxColumn; column++)
+	{
+		for (NSInteger row = entry->minRow; row <= entry->maxRow; row++)
+		{
+			NSNumber *key = ETCellKey(column, row);
+			NSMutableSet *cell = _cells[key];
+
+			[cell removeObject: entry];
+			if ([cell count] == 0)
+			{
+				[_cells removeObjectForKey: key];
+			}
+		}
+	}
+}
+
+/** Indexes the item with the given rect and order, or moves it in the grid 
+when the item is already indexed. */
+- (void) setRect: (NSRect)aRect order: (NSUInteger)anOrder forItem: (ETLayoutItem *)anItem
+{
+	NSParameterAssert(anItem != nil);
+	ETSpatialIndexEntry *entry = [_entries objectForKey: anItem];
+
+	if (entry == nil)
+	{
+		entry = [ETSpatialIndexEntry new];
+		entry->item = anItem;
+		[_entries setObject: entry forKey: anItem];
+	}
+	else
+	{
+		[self removeEntryFromCells: entry];
+	}
+
+	entry->rect = aRect;
+	entry->order = anOrder;
+	[self computeCellRangeForEntry: entry];
+	[self insertEntryIntoCells: entry];
+}
+
+/** Updates the rect of an indexed item and keeps its order.
+
+Does nothing if the item is not indexed. */
+- (void) setRect: (NSRect)aRect forItem: (ETLayoutItem *)anItem
+{
+	ETSpatialIndexEntry *entry = [_entries objectForKey: anItem];
+
+	if (entry == nil || NSEqualRects(entry->rect, aRect))
+		return;
+
+	[self setRect: aRect order: entry->order forItem: anItem];
+}
+
+/** Removes the item from the index. */
+- (void) removeItem: (ETLayoutItem *)anItem
+{
+	ETSpatialIndexEntry *entry = [_entries objectForKey: anItem];
+
+	if (entry == nil)
+		return;
+
+	[self removeEntryFromCells: entry];
+	[_entries removeObjectForKey: anItem];
+}
+
+/** Removes all the items from the index. */
+- (void) removeAllItems
+{
+	[_cells removeAllObjects];
+	[_overflowEntries removeAllObjects];
+	[_entries removeAllObjects];
+}
+
+/** Returns whether the item is indexed. */
+- (BOOL) containsItem: (ETLayoutItem *)anItem
+{
+	return ([_entries objectForKey: anItem] != nil);
+}
+
+/** Returns the rect used to index the item, or ETNullRect when the item is 
+not indexed. */
+- (NSRect) rectForItem: (ETLayoutItem *)anItem
+{
+	ETSpatialIndexEntry *entry = [_entries objectForKey: anItem];
+	return (entry != nil ? entry->rect : ETNullRect);
+}
+
+- (NSUInteger) count
+{
+	return [_entries count];
+}
+
+static NSComparisonResult compareEntriesByDecreasingOrder(id entry1, id entry2, void *context)
+{
+	NSUInteger order1 = ((ETSpatialIndexEntry *)entry1)->order;
+	NSUInteger order2 = ((ETSpatialIndexEntry *)entry2)->order;
+
+	if (order1 == order2)
+		return NSOrderedSame;
+
+	return (order1 > order2 ? NSOrderedAscending : NSOrderedDescending);
+}
+
+- (void) collectEntry: (ETSpatialIndexEntry *)entry
+      intersectingRect: (NSRect)aRect
+             inEntries: (NSMutableArray *)matchingEntries
+{
+	if (entry->queryStamp == _queryStamp)
+		return;
+
+	entry->queryStamp = _queryStamp;
+
+	if (NSIntersectsRect(entry->rect, aRect))
+	{
+		[matchingEntries addObject: entry];
+	}
+}
+
+/** Returns the indexed items whose rect intersects the given rect, sorted by 
+decreasing order.
+
+When the rect covers more cells than there are indexed items, or is not 
+finite, the items are checked one by one rather than cell by cell. */
+- (NSArray *) itemsIntersectingRect: (NSRect)aRect
+{
+	NSMutableArray *matchingEntries = [NSMutableArray array];
+
+	if (NSIsEmptyRect(aRect) || [_entries count] == 0)
+		return matchingEntries;
+
+	double minColumn, maxColumn, minRow, maxRow;
+	double nbOfCoveredCells = ETCoveredCellRange(aRect, _cellSize,
+		&minColumn, &maxColumn, &minRow, &maxRow);
+
+	_queryStamp++;
+
+	if (nbOfCoveredCells > [_entries count])
+	{
+		for (ETSpatialIndexEntry *entry in [_entries objectEnumerator])
+		{
+			[self collectEntry: entry intersectingRect: aRect inEntries: matchingEntries];
+		}
+	}
+	else
+	{
+		for (NSInteger column = minColumn; column <= (NSInteger)maxColumn; column++)
+		{
+			for (NSInteger row = minRow; row <= (NSInteger)maxRow; row++)
+			{
+				for (ETSpatialIndexEntry *entry in _cells[ETCellKey(column, row)])
+				{
+					[self collectEntry: entry intersectingRect: aRect inEntries: matchingEntries];
+				}
+			}
+		}
+		for (ETSpatialIndexEntry *entry in _overflowEntries)
+		{
+			[self collectEntry: entry intersectingRect: aRect inEntries: matchingEntries];
+		}
+	}
+
+	[matchingEntries sortUsingFunction: compareEntriesByDecreasingOrder context: NULL];
+
+	NSMutableArray *items = [NSMutableArray arrayWithCapacity: [matchingEntries count]];
+
+	for (ETSpatialIndexEntry *entry in matchingEntries)
+	{
+		[items addObject: entry->item];
+	}
+	return items;
+}
+
+@end
@@ -0,0 +1,215 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <EtoileFoundation/Macros.h>
+#import "ETTextMetricsCache.h"
+#import "ETCompatibility.h"
+
+#define DEFAULT_CAPACITY 1024
+
+/* A cached size, linked to the previous and next entries in the recently used 
+order */
+@interface ETTextMetricsEntry : NSObject
+{
+	@public
+	NSString *_string;
+	NSDictionary *_attributes;
+	NSSize _size;
+	ETTextMetricsEntry *_next;
+	__unsafe_unretained ETTextMetricsEntry *_previous;
+}
+@end
+
+@implementation ETTextMetricsEntry
+@end
+
+
+@implementation ETTextMetricsCache
+
+static ETTextMetricsCache *sharedInstance = nil;
+
++ (void) initialize
+{
+	if ([self isEqual: [ETTextMetricsCache class]] == NO)
+		return;
+
+	sharedInstance = [[self alloc] init];
+}
+
+/** Returns the text metrics cache shared by the styles and layouts. */
++ (instancetype) sharedInstance
+{
+	return sharedInstance;
+}
+
+/** <init />
+Initializes and returns a new cache that keeps at most the given number of 
+sizes. */
+- (instancetype) initWithCapacity: (NSUInteger)aCapacity
+{
+	INVALIDARG_EXCEPTION_TEST(aCapacity, aCapacity > 0);
+	SUPERINIT;
+	_capacity = aCapacity;
+	_entriesByAttributes = [[NSMutableDictionary alloc] init];
+	return self;
+}
+
+- (instancetype) init
+{
+	return [self initWithCapacity: DEFAULT_CAPACITY];
+}
+
+- (NSString *) description
+{
+	return [NSString stringWithFormat: @"%@ count %lu capacity %lu hits %lu misses %lu",
+		[super description], (unsigned long)_count, (unsigned long)_capacity,
+		(unsigned long)_hitCount, (unsigned long)_missCount];
+}
+
+- (void) unlinkEntry: (ETTextMetricsEntry *)anEntry
+{
+	if (anEntry->_previous != nil)
+	{
+		anEntry->_previous->_next = anEntry->_next;
+	}
+	else
+	{
+		_mostRecentEntry = anEntry->_next;
+	}
+
+	if (anEntry->_next != nil)
+	{
+		anEntry->_next->_previous = anEntry->_previous;
+	}
+	else
+	{
+		_leastRecentEntry = anEntry->_previous;
+	}
+
+	anEntry->_previous = nil;
+	anEntry->_next = nil;
+}
+
+- (void) linkEntryAsMostRecent: (ETTextMetricsEntry *)anEntry
+{
+	anEntry->_next = _mostRecentEntry;
+	anEntry->_previous = nil;
+
+	if (_mostRecentEntry != nil)
+	{
+		_mostRecentEntry->_previous = anEntry;
+	}
+	_mostRecentEntry = anEntry;
+
+	if (_leastRecentEntry == nil)
+	{
+		_leastRecentEntry = anEntry;
+	}
+}
+
+- (void) evictLeastRecentEntry
+{
+	ETTextMetricsEntry *entry = _leastRecentEntry;
+	NSMutableDictionary *entriesByString = _entriesByAttributes[entry->_attributes];
+
+	[self unlinkEntry: entry];
+	[entriesByString removeObjectForKey: entry->_string];
+
+	if ([entriesByString count] == 0)
+	{
+		[_entriesByAttributes removeObjectForKey: entry->_attributes];
+	}
+	_count--;
+}
+
+/** Returns the size of the string drawn with the given attributes, as 
+-[NSString sizeWithAttributes:] does.
+
+The string is measured only if no size was cached for an equal string and 
+equal attributes.
+
+For a nil string, returns NSZeroSize and caches nothing. */
+- (NSSize) sizeOfString: (NSString *)aString withAttributes: (NSDictionary *)attributes
+{
+	/* Labels such as -[ETTokenStyle labelForItem:] can be nil, and 
+	   -sizeWithAttributes: sent to nil used to return a zero size */
+	if (aString == nil)
+		return NSZeroSize;
+
+	/* The attributes are looked up first, since a few attribute dictionaries 
+	   are usually shared by many strings */
+	NSDictionary *attributesKey = (attributes != nil ? attributes : @{});
+	NSMutableDictionary *entriesByString = _entriesByAttributes[attributesKey];
+	ETTextMetricsEntry *entry = entriesByString[aString];
+
+	if (entry != nil)
+	{
+		_hitCount++;
+
+		if (entry != _mostRecentEntry)
+		{
+			[self unlinkEntry: entry];
+			[self linkEntryAsMostRecent: entry];
+		}
+		return entry->_size;
+	}
+
+	_missCount++;
+
+	if (_count == _capacity)
+	{
+		[self evictLeastRecentEntry];
+		/* Eviction can discard the dictionary for the attributes */
+		entriesByString = _entriesByAttributes[attributesKey];
+	}
+	if (entriesByString == nil)
+	{
+		attributesKey = [attributesKey copy];
+		entriesByString = [NSMutableDictionary dictionary];
+		_entriesByAttributes[attributesKey] = entriesByString;
+	}
+
+	entry = [[ETTextMetricsEntry alloc] init];
+	entry->_string = [aString copy];
+	entry->_attributes = attributesKey;
+	entry->_size = [aString sizeWithAttributes: attributes];
+
+	entriesByString[entry->_string] = entry;
+	[self linkEntryAsMostRecent: entry];
+	_count++;
+
+	return entry->_size;
+}
+
+/** Discards all the cached sizes.
+
+The hit and miss counters are not reset, see -resetStatistics. */
+- (void) removeAllSizes
+{
+	/* Break the strong next links one entry at a time, rather than releasing 
+	   the whole list recursively */
+	while (_mostRecentEntry != nil)
+	{
+		ETTextMetricsEntry *entry = _mostRecentEntry;
+
+		_mostRecentEntry = entry->_next;
+		entry->_next = nil;
+	}
+	_leastRecentEntry = nil;
+	[_entriesByAttributes removeAllObjects];
+	_count = 0;
+}
+
+/** Resets the hit and miss counters to zero. */
+- (void) resetStatistics
+{
+	_hitCount = 0;
+	_missCount = 0;
+}
+
+@end
@@ -0,0 +1,286 @@
+/*
+	Copyright (C) 2026 agent
+
+	Author:  agent <agent@local>
+	Date:  October 2026
+	License:  Modified BSD (see COPYING)
+ */
+
+#import <EtoileFoundation/Macros.h>
+#import "ETThumbnailCache.h"
+#import "NSImage+NiceScaling.h"
+#import "ETCompatibility.h"
+
+#define DEFAULT_MAX_MEMORY_COST (64 * 1024 * 1024)
+#define MIN_LEVEL_SIDE 16
+
+/* A thumbnail, linked to the previous and next entries in the recently used 
+order */
+@interface ETThumbnailEntry : NSObject
+{
+	@public
+	__weak NSImage *_image;
+	NSNumber *_level;
+	NSImage *_thumbnail;
+	NSUInteger _cost;
+	ETThumbnailEntry *_next;
+	__unsafe_unretained ETThumbnailEntry *_previous;
+}
+@end
+
+@implementation ETThumbnailEntry
+@end
+
+
+@implementation ETThumbnailCache
+
+static ETThumbnailCache *sharedInstance = nil;
+
++ (void) initialize
+{
+	if ([self isEqual: [ETThumbnailCache class]] == NO)
+		return;
+
+	sharedInstance = [[self alloc] init];
+}
+
+/** Returns the thumbnail cache shared by the styles. */
++ (instancetype) sharedInstance
+{
+	return sharedInstance;
+}
+
+- (instancetype) init
+{
+	SUPERINIT;
+	_maxMemoryCost = DEFAULT_MAX_MEMORY_COST;
+	_levelsByImage = [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+	                                       valueOptions: NSPointerFunctionsStrongMemory];
+	return self;
+}
+
+- (NSString *) description
+{
+	return [NSString stringWithFormat: @"%@ memoryCost %lu maxMemoryCost %lu hits %lu misses %lu",
+		[super description], (unsigned long)_memoryCost, (unsigned long)_maxMemoryCost,
+		(unsigned long)_hitCount, (unsigned long)_missCount];
+}
+
+- (void) unlinkEntry: (ETThumbnailEntry *)anEntry
+{
+	if (anEntry->_previous != nil)
+	{
+		anEntry->_previous->_next = anEntry->_next;
+	}
+	else
+	{
+		_mostRecentEntry = anEntry->_next;
+	}
+
+	if (anEntry->_next != nil)
+	{
+		anEntry->_next->_previous = anEntry->_previous;
+	}
+	else
+	{
+		_leastRecentEntry = anEntry->_previous;
+	}
+
+	anEntry->_previous = nil;
+	anEntry->_next = nil;
+}
+
+- (void) linkEntryAsMostRecent: (ETThumbnailEntry *)anEntry
+{
+	anEntry->_next = _mostRecentEntry;
+	anEntry->_previous = nil;
+
+	if (_mostRecentEntry != nil)
+	{
+		_mostRecentEntry->_previous = anEntry;
+	}
+	_mostRecentEntry = anEntry;
+
+	if (_leastRecentEntry == nil)
+	{
+		_leastRecentEntry = anEntry;
+	}
+}
+
+- (void) removeEntry: (ETThumbnailEntry *)anEntry
+{
+	NSImage *image = anEntry->_image;
+	/* When the image is gone, the map table has already discarded its levels */
+	NSMutableDictionary *entriesByLevel = (image != nil ? [_levelsByImage objectForKey: image] : nil);
+
+	[self unlinkEntry: anEntry];
+	[entriesByLevel removeObjectForKey: anEntry->_level];
+
+	if (entriesByLevel != nil && [entriesByLevel count] == 0)
+	{
+		[_levelsByImage removeObjectForKey: image];
+	}
+	_memoryCost -= anEntry->_cost;
+}
+
+- (void) evictEntriesToFitMemoryCost: (NSUInteger)aCost
+{
+	while (_leastRecentEntry != nil && _memoryCost > aCost)
+	{
+		[self removeEntry: _leastRecentEntry];
+	}
+}
+
+- (NSUInteger) maxMemoryCost
+{
+	return _maxMemoryCost;
+}
+
+- (void) setMaxMemoryCost: (NSUInteger)aCost
+{
+	_maxMemoryCost = aCost;
+	[self evictEntriesToFitMemoryCost: aCost];
+}
+
+- (NSUInteger) memoryCost
+{
+	return _memoryCost;
+}
+
+/* Returns the largest side of the smallest level that covers the given size. */
+static CGFloat ETThumbnailLevelSideForSize(NSSize aSize)
+{
+	CGFloat maxSide = MAX(aSize.width, aSize.height);
+	CGFloat side = MIN_LEVEL_SIDE;
+
+	while (side < maxSide)
+	{
+		side *= 2;
+	}
+	return side;
+}
+
+/* Returns the size in pixels of the largest image representation, or the 
+image size when no representation has a pixel size (e.g. a PDF image). */
+static NSSize ETPixelSizeOfImage(NSImage *anImage)
+{
+	NSSize pixelSize = NSZeroSize;
+
+	for (NSImageRep *rep in [anImage representations])
+	{
+		pixelSize.width = MAX(pixelSize.width, [rep pixelsWide]);
+		pixelSize.height = MAX(pixelSize.height, [rep pixelsHigh]);
+	}
+	return (pixelSize.width > 0 && pixelSize.height > 0 ? pixelSize : [anImage size]);
+}
+
+/** Returns a scaled down copy of the image, that can be drawn without visible 
+loss in a rect which covers the given number of device pixels.
+
+For a rect in points, the pixel size is the rect size multiplied by 
+-[ETRenderContext scaleFactor].
+
+The returned thumbnail keeps the image aspect ratio, and its largest side in 
+pixels is the smallest power of two that covers the given size. When the image 
+is not larger than this level, the image itself is returned. The thumbnail 
+size is its pixel size, so it must be drawn with -drawInRect:fromRect:XXX.
+
+The thumbnail is scaled with a high interpolation the first time, then reused 
+until evicted. */
+- (NSImage *) thumbnailForImage: (NSImage *)anImage fittingPixelSize: (NSSize)aSize
+{
+	NILARG_EXCEPTION_TEST(anImage);
+
+	NSSize imageSize = ETPixelSizeOfImage(anImage);
+	CGFloat side = ETThumbnailLevelSideForSize(aSize);
+
+	if (side >= MAX(imageSize.width, imageSize.height))
+		return anImage;
+
+	NSNumber *level = @(side);
+	NSMutableDictionary *entriesByLevel = [_levelsByImage objectForKey: anImage];
+	ETThumbnailEntry *entry = entriesByLevel[level];
+
+	if (entry != nil)
+	{
+		_hitCount++;
+
+		if (entry != _mostRecentEntry)
+		{
+			[self unlinkEntry: entry];
+			[self linkEntryAsMostRecent: entry];
+		}
+		return entry->_thumbnail;
+	}
+
+	_missCount++;
+
+	NSSize thumbnailSize = [NSImage scaledSize: imageSize toFitSize: NSMakeSize(side, side)];
+	NSImage *thumbnail = [anImage scaledImageToFitSize: thumbnailSize];
+	NSUInteger cost = ceil(thumbnailSize.width) * ceil(thumbnailSize.height) * 4;
+
+	if (thumbnail == nil || cost > _maxMemoryCost)
+		return (thumbnail != nil ? thumbnail : anImage);
+
+	[self evictEntriesToFitMemoryCost: _maxMemoryCost - cost];
+
+	/* Eviction can discard the dictionary for the image */
+	entriesByLevel = [_levelsByImage objectForKey: anImage];
+
+	if (entriesByLevel == nil)
+	{
+		entriesByLevel = [NSMutableDictionary dictionary];
+		[_levelsByImage setObject: entriesByLevel forKey: anImage];
+	}
+
+	entry = [[ETThumbnailEntry alloc] init];
+	entry->_image = anImage;
+	entry->_level = level;
+	entry->_thumbnail = thumbnail;
+	entry->_cost = cost;
+
+	entriesByLevel[level] = entry;
+	[self linkEntryAsMostRecent: entry];
+	_memoryCost += cost;
+
+	return thumbnail;
+}
+
+/** Discards the thumbnails of the given image. */
+- (void) removeThumbnailsForImage: (NSImage *)anImage
+{
+	NILARG_EXCEPTION_TEST(anImage);
+
+	for (ETThumbnailEntry *entry in [[_levelsByImage objectForKey: anImage] allValues])
+	{
+		[self removeEntry: entry];
+	}
+}
+
+/** Discards all the thumbnails.
+
+The hit and miss counters are not reset, see -resetStatistics. */
+- (void) removeAllThumbnails
+{
+	/* Break the strong next links one entry at a time, rather than releasing 
+	   the whole list recursively */
+	while (_mostRecentEntry != nil)
+	{
+		ETThumbnailEntry *entry = _mostRecentEntry;
+
+		_mostRecentEntry = entry->_next;
+		entry->_next = nil;
+	}
+	_leastRecentEntry = nil;
+	[_levelsByImage removeAllObjects];
+	_memoryCost = 0;
+}
+
+/** Resets the hit and miss counters to zero. */
+- (void) resetStatistics
+{
+	_hitCount = 0;
+	_missCount = 0;
+}
+
+@end
@@ -55,6 +55,7 @@ NSString * const kETSubtypeProperty = @"subtype";
 NSString * const kETTargetProperty = @"target";
 NSString * const kETTransformProperty = @"transform";
 NSString * const kETUTIProperty = @"UTI";
+NSString * const kETUsesSpatialIndexProperty = @"usesSpatialIndex";
 NSString * const kETValueProperty = @"value";
 NSString * const kETValueKeyProperty = @"valueKey";
 NSString * const kETViewProperty = @"view";
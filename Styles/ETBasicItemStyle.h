@@ -82,6 +82,7 @@ makes the label invisible. */
 	CGFloat _edgeInset;
 	NSRect _currentLabelRect;
 	NSRect _currentImageRect;
+	CGFloat _currentScaleFactor;
 }
 
 + (NSDictionary *) standardLabelAttributes;
@@ -92,6 +93,7 @@ makes the label invisible. */
 
 @property (nonatomic, readonly) NSRect currentLabelRect;
 @property (nonatomic, readonly) NSRect currentImageRect;
+@property (nonatomic, readonly) CGFloat currentScaleFactor;
 
 /** @taskunit Drawing */
 
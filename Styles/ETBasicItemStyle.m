@@ -13,6 +13,9 @@
 #import "ETTool.h"
 #import "ETLayoutItemGroup.h"
 #import "ETLayoutItem.h"
+#import "ETRenderContext.h"
+#import "ETTextMetricsCache.h"
+#import "ETThumbnailCache.h"
 #import "EtoileUIProperties.h"
 // FIXME: Move related code to the Appkit graphics backend
 #import "ETWidgetBackend.h"
@@ -55,6 +58,7 @@ a label underneath. */
 {
 	_labelAttributes = [[self class] standardLabelAttributes];
 	_selectedLabelAttributes = [NSDictionary new];
+	_currentScaleFactor = 1;
 }
 
 /** <init />
@@ -80,16 +84,20 @@ no max image and label size and no edge inset. */
 	return [NSImage imageNamed: @"leaf"];
 }
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
       dirtyRect: (NSRect)dirtyRect
 {
+	renderContext = ETRenderContextFromInputValues(renderContext);
+
 	/* Compute Label And Image Geometry */
 
 	// FIXME: May be we should better support dirtyRect. The next drawing 
 	// methods don't take in account it and simply redraw all their content.
 	_currentLabelRect = NSZeroRect;
 	_currentImageRect = NSZeroRect;
+	/* The render context is nil when the style is rendered directly */
+	_currentScaleFactor = (renderContext != nil ? [renderContext scaleFactor] : 1);
 
 	NSRect bounds = [item drawingBoundsForStyle: self];
 	NSString *itemLabel = [self labelForItem: item];
@@ -110,45 +118,68 @@ no max image and label size and no edge inset. */
 		                         withLabelRect: _currentLabelRect];
 	}
 
-	/* Draw */
-
-	if (nil != itemImage)
+	/* The render context is nil when the style is rendered directly */
+	BOOL drawsSelectionIndicator = (renderContext == nil || [renderContext drawsSelectionIndicator]);
+	BOOL drawsFirstResponderIndicator = (renderContext == nil || [renderContext drawsFirstResponderIndicator]);
+	BOOL drawsStack = [self shouldDrawItemAsStack: item];
+	BOOL drawsSelection = (drawsSelectionIndicator && [self shouldDrawItemAsSelected: item]);
+	BOOL drawsFirstResponder = (drawsFirstResponderIndicator
+		&& [[[item firstResponderSharingArea] firstResponder] isEqual: item]);
+	BOOL isFlipped = [item isFlipped];
+	NSDictionary *labelAttributes = (nil != itemLabel ? [self labelAttributesForDrawingItem: item] : nil);
+	NSRect labelRect = _currentLabelRect;
+	NSRect imageRect = _currentImageRect;
+	CGFloat scaleFactor = _currentScaleFactor;
+
+	/* Draw (the geometry computed above is reused when a display list replays 
+	   the drawing) */
+
+	ETDraw(renderContext, ^ ()
 	{
-		[self drawImage: itemImage flipped: [item isFlipped] inRect: _currentImageRect]; 	
-	}
+		_currentLabelRect = labelRect;
+		_currentImageRect = imageRect;
+		_currentScaleFactor = scaleFactor;
 
-	if (nil != itemLabel)
-	{
-		if ([[item identifier] isEqual: @"collectionEditor"])
+		if (nil != itemImage)
 		{
-			//ETLog(@"Try to draw label in %@ of %@", NSStringFromRect(_currentLabelRect), item);
+			[self drawImage: itemImage flipped: isFlipped inRect: imageRect];
 		}
-		if ([[item name] isEqual: @"Width"])
+
+		if (nil != itemLabel)
 		{
-			//ETLog(@"Try to draw label in %@ of %@", NSStringFromRect(_currentLabelRect), item);
+			[self drawLabel: itemLabel
+			     attributes: labelAttributes
+			        flipped: isFlipped
+			         inRect: labelRect];
 		}
-		[self drawLabel: itemLabel
-		     attributes: [self labelAttributesForDrawingItem: item]
-		        flipped: [item isFlipped]
-		         inRect: _currentLabelRect];
-	}
 
-	if ([self shouldDrawItemAsStack: item])
-	{
-		[self drawStackIndicatorInRect: bounds];
-	}
+		if (drawsStack)
+		{
+			[self drawStackIndicatorInRect: bounds];
+		}
 
-	if ([self shouldDrawItemAsSelected: item])
-	{
-		[self drawSelectionIndicatorInRect: bounds];
-	}
+		if (drawsSelection)
+		{
+			[self drawSelectionIndicatorInRect: bounds];
+		}
 
-	if ([[[item firstResponderSharingArea] firstResponder] isEqual: item])
-	{
-		[self drawFirstResponderIndicatorInRect: bounds];
-	}
+		if (drawsFirstResponder)
+		{
+			[self drawFirstResponderIndicatorInRect: bounds];
+		}
+	});
+
+	[super render: renderContext layoutItem: item dirtyRect: dirtyRect];
+}
 
-	[super render: inputValues layoutItem: item dirtyRect: dirtyRect];
+/** Returns YES, unless a subclass overrides -render:layoutItem:dirtyRect:.
+
+Subclasses that override the drawing methods such as -drawLabel:attributes:flipped:inRect: 
+remain supported, since these methods are called by the recorded commands. */
+- (BOOL) supportsDisplayList
+{
+	SEL renderSel = @selector(render:layoutItem:dirtyRect:);
+	return ([[self class] instanceMethodForSelector: renderSel] == [ETBasicItemStyle instanceMethodForSelector: renderSel]);
 }
 
 /** Returns the last value computed for -rectForLabel:inFrame:ofItem:. 
@@ -169,30 +200,53 @@ means you can safely use it when overriding other drawing methods. */
 	return _currentImageRect;
 }
 
-/** Draws an image at the origin of the current graphics coordinates. */
+/** Returns the last -[ETRenderContext scaleFactor] passed to 
+-render:layoutItem:dirtyRect:, or 1 when the style was rendered without a 
+render context.
+
+This value is set at the beginning of -render:layoutItem:dirtyRect:. Which 
+means you can safely use it when overriding other drawing methods. */
+- (CGFloat) currentScaleFactor
+{
+	return _currentScaleFactor;
+}
+
+/** Draws an image at the origin of the current graphics coordinates.
+
+When the image is larger than the given rect in device pixels (based on 
+-currentScaleFactor), a thumbnail from -[ETThumbnailCache sharedInstance] is 
+drawn in place of the image. */
 - (void) drawImage: (NSImage *)itemImage flipped: (BOOL)itemFlipped inRect: (NSRect)aRect
 {
 	//ETLog(@"Drawing image %@ %@ flipped %d in view %@", itemImage, NSStringFromRect(aRect), [itemImage isFlipped], [NSView focusView]);
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wdeprecated-declarations"
-	BOOL flipMismatch = (itemFlipped && (itemFlipped != [itemImage isFlipped]));
+	BOOL isImageFlipped = [itemImage isFlipped];
 #pragma clang diagnostic pop
-	NSAffineTransform *xform = nil;
+	BOOL flipMismatch = (itemFlipped && (itemFlipped != isImageFlipped));
+
+	/* Thumbnails are drawn unflipped, see -[NSImage scaledImageToFitSize:] */
+	if (isImageFlipped == NO)
+	{
+		NSSize pixelSize = NSMakeSize(aRect.size.width * _currentScaleFactor,
+		                              aRect.size.height * _currentScaleFactor);
+
+		itemImage = [[ETThumbnailCache sharedInstance] thumbnailForImage: itemImage
+		                                                fittingPixelSize: pixelSize];
+	}
 
 	if (flipMismatch)
 	{
-		xform = [NSAffineTransform transform];
-		[xform translateXBy: aRect.origin.x yBy: aRect.origin.y + aRect.size.height];
-		[xform scaleXBy: 1.0 yBy: -1.0];
-		[xform concat];
+		ETRenderState flipState = ETRenderStateMake(aRect, YES, ETNullRect);
+
+		ETPushRenderState(flipState);
 
 		[itemImage drawInRect: ETMakeRect(NSZeroPoint, aRect.size)
 	                 fromRect: NSZeroRect // Draw the entire image
 	                operation: NSCompositeSourceOver 
 	                 fraction: 1.0];
 
-		[xform invert];
-		[xform concat];
+		ETPopRenderState(flipState);
 	}
 	else
 	{
@@ -221,16 +275,14 @@ means you can safely use it when overriding other drawing methods. */
 
 	if (flipMismatch)
 	{
-		NSAffineTransform *xform = [NSAffineTransform transform];
-		[xform translateXBy: aRect.origin.x yBy: aRect.origin.y + aRect.size.height];
-		[xform scaleXBy: 1.0 yBy: -1.0];
-		[xform concat];
+		ETRenderState flipState = ETRenderStateMake(aRect, YES, ETNullRect);
+
+		ETPushRenderState(flipState);
 
 		[aLabel drawInRect: ETMakeRect(NSZeroPoint, aRect.size) 
 		    withAttributes: attributes];
 
-		[xform invert];
-		[xform concat];
+		ETPopRenderState(flipState);
 	}
 	else
 	{
@@ -423,7 +475,8 @@ See also -labelAttributesForDrawingItem:. */
 	NSParameterAssert(nil != anItem);
 
 	NSSize boundingSize = [anItem boundingBox].size;
-	NSSize labelSize = [aLabel sizeWithAttributes: _labelAttributes];
+	NSSize labelSize = [[ETTextMetricsCache sharedInstance] sizeOfString: aLabel
+	                                                       withAttributes: _labelAttributes];
 	CGFloat maxLabelWidth = (_maxLabelSize.width != ETNullSize.width ? _maxLabelSize.width : boundingSize.width);
 	CGFloat maxLabelHeight = (_maxLabelSize.height != ETNullSize.height ? _maxLabelSize.height : boundingSize.height);
 	CGFloat labelSizeWidth = MIN(labelSize.width, maxLabelWidth);
@@ -545,8 +598,8 @@ Returns the display name which is never nil.<br />
 The label won't be drawn when -labelPosition returns ETLabelPositionNone.  */
 - (NSString *) labelForItem: (ETLayoutItem *)anItem
 {
-	// TODO: We probably want extra flexibility. e.g. kETShouldDrawGroupLabelHint 
-	// set by the parent item in inputValues based on the layout. 
+	// TODO: We probably want extra flexibility. e.g. a drawsGroupLabel flag 
+	// set by the parent item in the render context based on the layout. 
 	// ETLayoutItemGroup might want to query the layout with 
 	// -[ETLayout shouldLayoutContextDraws(All)ItemLabel].
 	return [anItem displayName];
@@ -573,7 +626,8 @@ with -[ETLayoutItem setBoundingBox:]. */
 	CGFloat imgWidth = MIN(imgSize.width, maxImgWidth);
 	CGFloat imgHeight = MIN(imgSize.height, maxImgHeight);
 
-	NSSize labelSize = [[self labelForItem: anItem] sizeWithAttributes: _labelAttributes];
+	NSSize labelSize = [[ETTextMetricsCache sharedInstance] sizeOfString: [self labelForItem: anItem]
+	                                                       withAttributes: _labelAttributes];
 	CGFloat maxLabelWidth = (_maxLabelSize.width != ETNullSize.width ? _maxLabelSize.width : labelSize.width);
 	CGFloat maxLabelHeight = (_maxLabelSize.height != ETNullSize.height ? _maxLabelSize.height : labelSize.height);
 	CGFloat labelWidth = MIN(labelSize.width, maxLabelWidth);
@@ -895,7 +949,7 @@ See also -edgeInset. */
 	return [NSImage imageNamed: @"layers-group"];
 }
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
 	  dirtyRect: (NSRect)dirtyRect
 {
@@ -919,7 +973,7 @@ See also -edgeInset. */
 	return [NSImage imageNamed: @"selection-input"];
 }
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
 	  dirtyRect: (NSRect)dirtyRect
 {
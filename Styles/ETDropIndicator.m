@@ -42,7 +42,7 @@
 
 // FIXME: Handle layout orientation, only works with horizontal layout
 // currently, in other words the insertion indicator is always vertical.
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
 	  dirtyRect: (NSRect)dirtyRect
 {
@@ -10,6 +10,7 @@
 #import "ETShadowStyle.h"
 #import "ETGeometry.h"
 #import "ETLayoutItem.h"
+#import "ETRenderContext.h"
 
 @implementation ETShadowStyle
 
@@ -40,17 +41,38 @@
 	return [NSImage imageNamed: @"edit-shadow"];
 }
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
 	  dirtyRect: (NSRect)dirtyRect
 {
+	renderContext = ETRenderContextFromInputValues(renderContext);
+
 	// FIXME: This will usually draw outside of item's frame..
 	//        A shadow should increase the size of the item's frame.
 	//        Maybe the shadow style should be a decorator item instead?
-	[NSGraphicsContext saveGraphicsState];
-	[_shadow set];
-	[_content render: inputValues layoutItem: item dirtyRect: dirtyRect];
-	[NSGraphicsContext restoreGraphicsState];
+	NSShadow *shadow = _shadow;
+
+	ETDraw(renderContext, ^ ()
+	{
+		[NSGraphicsContext saveGraphicsState];
+		[shadow set];
+	});
+	[_content render: renderContext layoutItem: item dirtyRect: dirtyRect];
+	ETDraw(renderContext, ^ ()
+	{
+		[NSGraphicsContext restoreGraphicsState];
+	});
+}
+
+/** Returns whether the shadowed style supports display lists. */
+- (BOOL) supportsDisplayList
+{
+	return [_content supportsDisplayList];
+}
+
+- (NSUInteger) displayListRevision
+{
+	return MAX([super displayListRevision], [_content displayListRevision]);
 }
 
 - (void) didChangeItemBounds: (NSRect)bounds
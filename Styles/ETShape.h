@@ -64,7 +64,7 @@ will remain and be put through next renderers. */
 /*- (BOOL) isMask;
 - (void) setMask: (BOOL)flag;*/
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
 	  dirtyRect: (NSRect)dirtyRect;
 - (void) drawInRect: (NSRect)rect;
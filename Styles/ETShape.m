@@ -11,6 +11,7 @@
 #import "NSObject+EtoileUI.h"
 #import "ETCompatibility.h"
 #import "ETLayoutItem.h"
+#import "ETRenderContext.h"
 
 typedef NSBezierPath* (*PathProviderFunction)(id, SEL, NSRect);
 
@@ -258,18 +259,31 @@ are notified. */
 	[self didChangeValueForProperty: @"hidden"];
 }
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
 	  dirtyRect: (NSRect)dirtyRect;
 {
-	NSRect bounds = [item drawingBoundsForStyle: self];
+	renderContext = ETRenderContextFromInputValues(renderContext);
 
-	[self drawInRect: bounds];
+	NSRect bounds = [item drawingBoundsForStyle: self];
+	BOOL isSelected = [item isSelected];
 
-	if ([item isSelected])
+	ETDraw(renderContext, ^ ()
 	{
-		[self drawSelectionIndicatorInRect: bounds];
-	}
+		[self drawInRect: bounds];
+
+		if (isSelected)
+		{
+			[self drawSelectionIndicatorInRect: bounds];
+		}
+	});
+}
+
+/** Returns YES, unless a subclass overrides -render:layoutItem:dirtyRect:. */
+- (BOOL) supportsDisplayList
+{
+	SEL renderSel = @selector(render:layoutItem:dirtyRect:);
+	return ([[self class] instanceMethodForSelector: renderSel] == [ETShape instanceMethodForSelector: renderSel]);
 }
 
 - (void) drawInRect: (NSRect)rect
@@ -86,7 +86,7 @@
 	return [NSImage imageNamed: @"balloon-left"];
 }
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
 	  dirtyRect: (NSRect)dirtyRect
 {
@@ -151,7 +151,7 @@
 		[xform concat];
 	}
 	
-	[_content render: inputValues layoutItem: item dirtyRect: dirtyRect];
+	[_content render: renderContext layoutItem: item dirtyRect: dirtyRect];
 	
 	[NSGraphicsContext restoreGraphicsState];
 }
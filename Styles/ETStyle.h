@@ -12,7 +12,7 @@
 #import <EtoileUI/ETUIObject.h>
 
 @class COObjectGraphContext;
-@class ETLayoutItem;
+@class ETLayoutItem, ETRenderContext;
 
 /** @abstract Base class to implement pluggable styles as subclasses and make
  possible UI styling at runtime.
@@ -47,6 +47,7 @@ rather than -initWithObjectGraphContext:.  */
 {
 	@private
 	BOOL _isShared;
+	NSUInteger _displayListRevision;
 }
 
 /** @taskunit Aspect Registration */
@@ -62,10 +63,17 @@ rather than -initWithObjectGraphContext:.  */
 
 /** @taskunit Style Rendering */
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
       dirtyRect: (NSRect)dirtyRect;
 
+/** @taskunit Display Lists */
+
+@property (nonatomic, readonly) BOOL supportsDisplayList;
+@property (nonatomic, readonly) NSUInteger displayListRevision;
+
+- (void) incrementDisplayListRevision;
+
 /** @taskunit Drawing Primitives */
 	  
 - (void) drawSelectionIndicatorInRect: (NSRect)indicatorRect;
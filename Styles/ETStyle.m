@@ -165,6 +165,10 @@ See -[ETLayoutItem drawingBoundsForStyle:] to retrieve the right drawing area.
 dirtyRect can be used to optimize the drawing. You only need to redraw what is 
 inside that redisplayed area and won't be clipped by the graphics context.
 
+renderContext carries the drawing options set by the items being rendered, 
+such as -[ETRenderContext drawsSelectionIndicator]. It can be nil when the 
+style is rendered outside of an item tree.
+
 Here is how the method can be implemented in a subclass:
 
 <example>
@@ -179,13 +183,61 @@ NSRect bounds = [item drawingBoundsForStyle: self];
 
 [NSGraphicsContext restoreGraphicsState];
 </example> */
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
       dirtyRect: (NSRect)dirtyRect
 {
 
 }
 
+/** <override-dummy />
+Returns whether -render:layoutItem:dirtyRect: draws everything through 
+ETDraw(), so the output can be recorded in a display list and 
+replayed later (see -[ETLayoutItem recordsDisplayList]).
+
+The recorded output must depend only on the style properties and the 
+ETDisplayListInputs, and not on the dirty rect.
+
+By default, returns YES when the receiver class doesn't override 
+-render:layoutItem:dirtyRect:, since ETStyle draws nothing. */
+- (BOOL) supportsDisplayList
+{
+	SEL renderSel = @selector(render:layoutItem:dirtyRect:);
+	return ([[self class] instanceMethodForSelector: renderSel] == [ETStyle instanceMethodForSelector: renderSel]);
+}
+
+/* The last revision given to a style, shared by all the styles */
+static NSUInteger lastDisplayListRevision = 0;
+
+/** <override-dummy />
+Returns a number that increases every time a receiver property changes, so the 
+display lists recorded with a previous revision can be discarded.
+
+The revisions are drawn from a counter shared by all the styles, so a changed 
+style always has a revision greater than the revision of any other style. 
+Styles that render other styles must return the maximum of their own revision 
+and the revisions of these styles. */
+- (NSUInteger) displayListRevision
+{
+	return _displayListRevision;
+}
+
+/** Gives a new -displayListRevision to the receiver.
+
+Must be called when a property that affects the drawing changes without 
+-didChangeValueForProperty: being called. */
+- (void) incrementDisplayListRevision
+{
+	_displayListRevision = ++lastDisplayListRevision;
+}
+
+/** Increments -displayListRevision, in addition to the superclass behavior. */
+- (void) didChangeValueForProperty: (NSString *)key
+{
+	[self incrementDisplayListRevision];
+	[super didChangeValueForProperty: key];
+}
+
 /** Draws a selection indicator that covers the whole item frame if 
  the given indicator rect is equal to it. */
 - (void) drawSelectionIndicatorInRect: (NSRect)indicatorRect
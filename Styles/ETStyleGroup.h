@@ -12,7 +12,7 @@
 #import <EtoileUI/ETStyle.h>
 
 @class COObjectGraphContext;
-@class ETLayoutItem;
+@class ETLayoutItem, ETRenderContext;
 
 /** @abstract A collection of ETStyle objects to be drawn in a given order.
  
@@ -59,7 +59,7 @@ default they return NO for -isShared unlike ETStyle.  */
 
 /** @taskunit Style Rendering */
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
 	  dirtyRect: (NSRect)dirtyRect;
 
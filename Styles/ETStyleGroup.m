@@ -10,6 +10,7 @@
 #import <EtoileFoundation/Macros.h>
 #import <CoreObject/COPrimitiveCollection.h>
 #import "ETStyleGroup.h"
+#import "ETRenderContext.h"
 #import "ETCompatibility.h"
 
 #pragma GCC diagnostic ignored "-Wprotocol"
@@ -159,16 +160,44 @@ to the style group or nil.
 
 dirtyRect can be used to optimize the drawing. You only need to redraw what is 
 inside that redisplayed area and won't be clipped by the graphics context. */
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
 	  dirtyRect: (NSRect)dirtyRect
 {
+	renderContext = ETRenderContextFromInputValues(renderContext);
+
 	for (ETStyle *style in _styles)
 	{
-		[style render: inputValues layoutItem: item dirtyRect: dirtyRect];
+		[style render: renderContext layoutItem: item dirtyRect: dirtyRect];
 	}
 }
 	  
+/** Returns YES when every style in the receiver supports display lists. */
+- (BOOL) supportsDisplayList
+{
+	for (ETStyle *style in _styles)
+	{
+		if ([style supportsDisplayList] == NO)
+			return NO;
+	}
+	return YES;
+}
+
+/** Returns a revision that changes when the receiver or any style in it 
+changes.
+
+Adding, inserting or removing a style gives a new revision to the receiver. */
+- (NSUInteger) displayListRevision
+{
+	NSUInteger revision = [super displayListRevision];
+
+	for (ETStyle *style in _styles)
+	{
+		revision = MAX(revision, [style displayListRevision]);
+	}
+	return revision;
+}
+
 /** Notifies every style with -didChangeItemBounds: to let it know that the 
 item, to which the receiver is bound to, has been resized. */
 - (void) didChangeItemBounds: (NSRect)bounds
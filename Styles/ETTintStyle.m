@@ -10,6 +10,7 @@
 #import "ETTintStyle.h"
 #import "ETGeometry.h"
 #import "ETLayoutItem.h"
+#import "ETRenderContext.h"
 
 @implementation ETTintStyle
 
@@ -44,6 +45,7 @@
 - (void) setColor: (NSColor *)color
 {
 	_color = color;
+	[self incrementDisplayListRevision];
 }
 
 - (NSColor *) color
@@ -51,16 +53,35 @@
 	return _color;
 }
 
-- (void) render: (NSMutableDictionary *)inputValues 
+- (void) render: (ETRenderContext *)renderContext 
      layoutItem: (ETLayoutItem *)item 
 	  dirtyRect: (NSRect)dirtyRect
 {
-	[_content render: inputValues layoutItem: item dirtyRect: dirtyRect];
-	
-	[NSGraphicsContext saveGraphicsState];
-	[_color set];
-	NSRectFillUsingOperation([item drawingBoundsForStyle: self], NSCompositeSourceOver);
-	[NSGraphicsContext restoreGraphicsState];
+	renderContext = ETRenderContextFromInputValues(renderContext);
+
+	[_content render: renderContext layoutItem: item dirtyRect: dirtyRect];
+
+	NSColor *color = _color;
+	NSRect bounds = [item drawingBoundsForStyle: self];
+
+	ETDraw(renderContext, ^ ()
+	{
+		[NSGraphicsContext saveGraphicsState];
+		[color set];
+		NSRectFillUsingOperation(bounds, NSCompositeSourceOver);
+		[NSGraphicsContext restoreGraphicsState];
+	});
+}
+
+/** Returns whether the tinted style supports display lists. */
+- (BOOL) supportsDisplayList
+{
+	return [_content supportsDisplayList];
+}
+
+- (NSUInteger) displayListRevision
+{
+	return MAX([super displayListRevision], [_content displayListRevision]);
 }
 
 - (void) didChangeItemBounds: (NSRect)bounds
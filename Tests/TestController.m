@@ -353,6 +353,11 @@
 	[controller setSortDescriptors: 
 		@[[[[controller sortDescriptors] firstObject] reversedSortDescriptor]]];
 
+	UKIntsEqual(3, [content numberOfArrangedItems]);
+	UKObjectsSame(item3, [content arrangedItemAtIndex: 0]);
+	UKObjectsSame(item1, [content arrangedItemAtIndex: 2]);
+	UKIntsEqual(1, [content indexOfArrangedItem: item2]);
+
 	UKObjectsEqual(A(item3, item2, item1), [content arrangedItems]);
 	UKObjectsEqual(initialItems, [content items]);
 	UKTrue([content isSorted]);
@@ -365,6 +370,8 @@
 	UKObjectsEqual(initialItems, [content items]);
 	UKFalse([content isSorted]);
 	UKFalse([content isFiltered]);
+	UKObjectsSame(item3, [content arrangedItemAtIndex: 0]);
+	UKIntsEqual(NSNotFound, [content indexOfArrangedItem: [itemFactory item]]);
 	// FIXME: UKTrue([content hasNewContent]);
 }
 
@@ -8,6 +8,7 @@
  */
 
 #import "TestCommon.h"
+#import "ETActionHandler.h"
 #import "ETApplication.h"
 #import "ETEvent.h"
 #import "ETFreeLayout.h"
@@ -19,6 +20,41 @@
 #import "ETSelectTool.h"
 #import "ETCompatibility.h"
 
+/* Counts the selection changes reported per item */
+@interface ETSelectionCountingActionHandler : ETActionHandler
+@end
+
+static NSUInteger nbOfSelectedItems = 0;
+static NSUInteger nbOfDeselectedItems = 0;
+
+@implementation ETSelectionCountingActionHandler
+
+- (void) handleSelect: (ETLayoutItem *)item
+{
+	nbOfSelectedItems++;
+	[super handleSelect: item];
+}
+
+- (void) handleDeselect: (ETLayoutItem *)item
+{
+	nbOfDeselectedItems++;
+	[super handleDeselect: item];
+}
+
+- (void) handleSelectItems: (NSArray *)items
+{
+	nbOfSelectedItems += [items count];
+	[super handleSelectItems: items];
+}
+
+- (void) handleDeselectItems: (NSArray *)items
+{
+	nbOfDeselectedItems += [items count];
+	[super handleDeselectItems: items];
+}
+
+@end
+
 @interface TestFreeLayout : TestEvent <UKTest>
 {
 	ETLayoutItemGroup *rootItem;
@@ -290,6 +326,104 @@
 	UKObjectsEqual(mainItem, [tool targetItem]);
 }
 
+- (void) testSelectAllAndDeselectAllInSinglePass
+{
+	[mainItem addItem: item2];
+	[self updateObservedItemsInTree];
+
+	__block NSUInteger nbOfNotifications = 0;
+	id observer = [[NSNotificationCenter defaultCenter]
+		addObserverForName: ETItemGroupSelectionDidChangeNotification
+		            object: mainItem
+		             queue: nil
+		        usingBlock: ^(NSNotification *notif) { nbOfNotifications++; }];
+
+	[tool selectAll: self];
+
+	UKIntsEqual(1, nbOfNotifications);
+	UKIntsEqual(2, [rootItem numberOfItems]);
+
+	[mainItem deselectAll];
+
+	UKIntsEqual(2, nbOfNotifications);
+	UKTrue([[mainItem selectedItems] isEmpty]);
+	UKIntsEqual(0, [rootItem numberOfItems]);
+
+	[mainItem deselectAll];
+	[[NSNotificationCenter defaultCenter] removeObserver: observer];
+
+	UKIntsEqual(2, nbOfNotifications);
+}
+
+- (void) testSelectAllAndDeselectAllWithCustomActionHandler
+{
+	ETActionHandler *handler = [ETSelectionCountingActionHandler 
+		sharedInstanceForObjectGraphContext: [mainItem objectGraphContext]];
+
+	[mainItem addItem: item2];
+	[self updateObservedItemsInTree];
+	[item1 setActionHandler: handler];
+	[item2 setActionHandler: handler];
+	nbOfSelectedItems = 0;
+	nbOfDeselectedItems = 0;
+
+	[tool selectAll: self];
+
+	UKIntsEqual(2, nbOfSelectedItems);
+	UKObjectsEqual(A(item1, item2), [mainItem selectedItems]);
+
+	[(ETSelectTool *)tool deselectAllWithItem: nil];
+
+	UKIntsEqual(2, nbOfDeselectedItems);
+	UKTrue([[mainItem selectedItems] isEmpty]);
+}
+
+- (void) testHandleSelectItemsInSeveralParents
+{
+	ETActionHandler *handler = [item1 actionHandler];
+
+	[mainItem addItem: item2];
+	[self updateObservedItemsInTree];
+	[handler handleSelectItems: A(item1, item21, item2)];
+
+	UKObjectsEqual(A(item1, item2), [mainItem selectedItems]);
+	UKObjectsEqual(A(item21), [item2 selectedItems]);
+
+	[handler handleDeselectItems: A(item21, item1)];
+
+	UKObjectsEqual(A(item2), [mainItem selectedItems]);
+	UKTrue([[item2 selectedItems] isEmpty]);
+}
+
+- (void) testResizeSelectionArea
+{
+	ETSelectTool *selectTool = (ETSelectTool *)tool;
+	ETLayoutItem *item3 = [itemFactory rectangleWithRect: NSMakeRect(200, 200, 20, 20)];
+
+	[mainItem addItem: item3];
+	[self updateObservedItemsInTree];
+	[item3 setSelected: YES];
+
+	[selectTool beginSelectingAreaAtPoint: NSZeroPoint];
+	[selectTool resizeSelectionAreaToPoint: NSMakePoint(60, 40)];
+
+	UKObjectsEqual(A(item1), [mainItem selectedItems]);
+
+	[selectTool resizeSelectionAreaToPoint: NSMakePoint(40, 40)];
+
+	UKTrue([[mainItem selectedItems] isEmpty]);
+
+	[selectTool resizeSelectionAreaToPoint: NSMakePoint(250, 250)];
+
+	UKObjectsEqual(A(item1, item3), [mainItem selectedItems]);
+
+	[selectTool resizeSelectionAreaToPoint: NSMakePoint(100, 100)];
+
+	UKObjectsEqual(A(item1), [mainItem selectedItems]);
+
+	[selectTool endSelectingArea];
+}
+
 - (void) testGroupAndUngroup
 {
 	[mainItem addItem: item2];
@@ -181,6 +181,60 @@ An F-script session is pasted at the file end to understand that more easily. */
 	UKObjectsSame(item3, [tool hitTestWithEvent: EVT(49, 100)]); /* Right on item1 and item2 bottom edge */
 }
 
+- (void) testHitTestWithLastHitItem
+{
+	ETLayoutItemGroup *item1 = [itemFactory itemGroupWithFrame: NSMakeRect(0, 0, 100, 100)];
+	ETLayoutItem *item11 = [itemFactory rectangleWithRect: NSMakeRect(10, 10, 20, 20)];
+	ETLayoutItem *item12 = [itemFactory rectangleWithRect: NSMakeRect(50, 50, 20, 20)];
+	ETLayoutItem *item2 = [itemFactory rectangleWithRect: NSMakeRect(0, 0, 20, 20)];
+
+	[item1 addItems: A(item11, item12)];
+	[mainItem addItem: item1];
+
+	UKObjectsSame(item11, [tool hitTestWithEvent: EVT(15, 15) lastHitItem: nil]);
+	UKObjectsSame(item11, [tool hitTestWithEvent: EVT(20, 20) lastHitItem: item11]);
+	UKObjectsSame(item12, [tool hitTestWithEvent: EVT(55, 55) lastHitItem: item11]);
+	UKObjectsSame(item1, [tool hitTestWithEvent: EVT(80, 80) lastHitItem: item12]);
+	UKObjectsSame(mainItem, [tool hitTestWithEvent: EVT(150, 150) lastHitItem: item12]);
+	UKObjectsSame(item12, [tool hitTestWithEvent: EVT(60, 60) lastHitItem: mainItem]);
+
+	/* A previous sibling inserted under the pointer takes precedence */
+	[mainItem insertItem: item2 atIndex: 0];
+
+	UKObjectsSame(item2, [tool hitTestWithEvent: EVT(15, 15) lastHitItem: item11]);
+	UKObjectsSame([tool hitTestWithEvent: EVT(15, 15)], [tool hitTestWithEvent: EVT(15, 15) lastHitItem: item11]);
+
+	/* A removed item is not resumed */
+	[item1 removeItem: item12];
+
+	UKObjectsSame(item1, [tool hitTestWithEvent: EVT(55, 55) lastHitItem: item12]);
+}
+
+- (void) testHitTestWithSpatialIndex
+{
+	ETLayoutItemGroup *item1 = [itemFactory itemGroupWithFrame: NSMakeRect(0, 0, 100, 100)];
+	ETLayoutItem *item11 = [itemFactory rectangleWithRect: NSMakeRect(10, 10, 20, 20)];
+	ETLayoutItem *item12 = [itemFactory rectangleWithRect: NSMakeRect(50, 50, 20, 20)];
+	ETLayoutItem *item2 = [itemFactory rectangleWithRect: NSMakeRect(0, 0, 20, 20)];
+
+	[mainItem setUsesSpatialIndex: YES];
+	[item1 setUsesSpatialIndex: YES];
+	[item1 addItems: A(item11, item12)];
+	[mainItem addItem: item1];
+
+	UKObjectsSame(item11, [tool hitTestWithEvent: EVT(15, 15)]);
+	UKObjectsSame(item12, [tool hitTestWithEvent: EVT(55, 55) lastHitItem: item11]);
+	UKObjectsSame(item1, [tool hitTestWithEvent: EVT(80, 80) lastHitItem: item12]);
+
+	/* A previous sibling inserted under the pointer takes precedence */
+	[mainItem insertItem: item2 atIndex: 0];
+
+	UKObjectsSame(item2, [tool hitTestWithEvent: EVT(15, 15)]);
+	UKObjectsSame(item2, [tool hitTestWithEvent: EVT(15, 15) lastHitItem: item11]);
+	UKObjectsSame(item2, [tool hitTestWithEvent: EVT(19, 19) lastHitItem: item11]);
+	UKObjectsSame(item11, [tool hitTestWithEvent: EVT(25, 25) lastHitItem: item11]);
+}
+
 - (void) testLookUpTool
 {
 	ETLayoutItem *item1 = [itemFactory rectangleWithRect: NSMakeRect(0, 0, 50, 100)];
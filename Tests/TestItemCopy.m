@@ -383,7 +383,7 @@
 	[itemGroup addItem: item3];
 
 	/* Layout view insertion doesn't call 
-	   -updateExposedViewsForItems:exposedIndexes:unexposedIndexes:, the 
+	   -updateExposedViewsForItems:, the 
 	   superview is nil until a layout update occurs. */
 	[itemGroup2 setLayout: [ETOutlineLayout layoutWithObjectGraphContext: [itemGroup2 objectGraphContext]]];
 	
@@ -8,11 +8,16 @@
  
 #import "TestCommon.h"
 #import "ETColumnLayout.h"
+#import "ETFlowLayout.h"
 #import "ETLayout.h"
 #import "ETLayoutItem.h"
 #import "ETLayoutItemFactory.h"
 #import "ETLayoutItemGroup.h"
+#import "ETLayoutItem+Scrollable.h"
 #import "ETLayoutExecutor.h"
+#import "ETLayoutTracer.h"
+#import "ETLineLayout.h"
+#import "ETScrollableAreaItem.h"
 #import "ETTableLayout.h"
 #import "ETCompatibility.h"
 
@@ -110,3 +115,666 @@
 }
 
 @end
+
+
+@interface ETLayoutExecutor (Private)
+- (BOOL) isFlexibleItem: (ETLayoutItemGroup *)anItem;
+- (void)updateHasNewContentForOpaqueItem: (ETLayoutItemGroup *)opaqueItem
+                          descendantItem: (ETLayoutItemGroup *)item;
+- (NSArray *) flexibleItemQueueForDirtyItems: (NSSet *)scheduledItems
+                            nonFlexibleItems: (NSMutableSet *)nonFlexibleItems;
+@end
+
+/* The flexible item ordering done by -executeWithDirtyItems: before the items 
+were bucketed by depth, to check the new ordering against it. */
+@interface ETLayoutExecutor (TestLayoutExecutor)
+- (NSArray *) previousFlexibleItemQueueForDirtyItems: (NSSet *)scheduledItems
+                                    nonFlexibleItems: (NSMutableSet *)nonFlexibleItems;
+@end
+
+@implementation ETLayoutExecutor (TestLayoutExecutor)
+
+- (void) insertItem: (ETLayoutItemGroup *)anItem 
+inPreviousFlexibleItemQueue: (NSMutableArray *)flexibleItemQueue
+{
+	[flexibleItemQueue removeObject: anItem];
+
+	NSUInteger nbOfQueuedItems = [flexibleItemQueue count];
+
+	for (NSUInteger i = 0; i < nbOfQueuedItems; i++)
+	{
+		if ([flexibleItemQueue[i] isEqual: [anItem parentItem]])
+		{
+			[flexibleItemQueue insertObject: anItem atIndex: i];
+			break;
+		}
+	}
+	if ([flexibleItemQueue count] == nbOfQueuedItems)
+	{
+		[flexibleItemQueue addObject: anItem];
+	}
+}
+
+- (NSArray *) previousFlexibleItemQueueForDirtyItems: (NSSet *)scheduledItems
+                                    nonFlexibleItems: (NSMutableSet *)nonFlexibleItems
+{
+	NSMutableSet *dirtyItems = [NSMutableSet setWithSet: scheduledItems];
+	NSMutableArray *flexibleItemQueue = [NSMutableArray array];
+	NSMutableSet *processedItems = [NSMutableSet set];
+
+	while ([dirtyItems count] > 0)
+	{
+		ETLayoutItemGroup *item = [dirtyItems anyObject];
+		ETLayoutItemGroup *opaqueItem = [item ancestorItemForOpaqueLayout];
+		ETLayoutItemGroup *parentItem = [item parentItem];
+
+		if (opaqueItem != item && opaqueItem != nil)
+		{
+			[dirtyItems addObject: opaqueItem];
+			[self updateHasNewContentForOpaqueItem: opaqueItem descendantItem: item];
+		}
+		else if ([self isFlexibleItem: item])
+		{
+			[self insertItem: item inPreviousFlexibleItemQueue: flexibleItemQueue];
+
+			if (parentItem != nil && [processedItems containsObject: parentItem] == NO)
+			{
+				[dirtyItems addObject: parentItem];
+			}
+			else if (parentItem != nil && [self isFlexibleItem: parentItem])
+			{
+				[self insertItem: parentItem inPreviousFlexibleItemQueue: flexibleItemQueue];
+			}
+		}
+		else
+		{
+			[nonFlexibleItems addObject: item];
+		}
+
+		[dirtyItems removeObject: item];
+		[processedItems addObject: item];
+	}
+	return flexibleItemQueue;
+}
+
+@end
+
+@interface TestLayoutExecutor : TestCommon <UKTest>
+{
+	ETLayoutExecutor *executor;
+	ETLayoutItemGroup *rootItem;
+	ETLayoutItemGroup *parentItem;
+	ETLayoutItemGroup *childItem;
+	ETLayoutItemGroup *otherChildItem;
+	ETLayoutItemGroup *grandChildItem;
+}
+
+@end
+
+@implementation TestLayoutExecutor
+
+- (ETLayoutItemGroup *) contentSizeItemGroup
+{
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroup];
+	ETColumnLayout *layout = [ETColumnLayout layoutWithObjectGraphContext: [itemGroup objectGraphContext]];
+
+	[[layout positionalLayout] setIsContentSizeLayout: YES];
+	[itemGroup setLayout: layout];
+	[itemGroup addItem: [self basicItemWithRect: NSMakeRect(0, 0, 50, 20)]];
+	return itemGroup;
+}
+
+/* Returns the root, parent, child, other child and grand child items of a new 
+tree, where every item except the root is a flexible item. */
+- (NSArray *) itemTree
+{
+	ETLayoutItemGroup *root = [itemFactory itemGroupWithSize: NSMakeSize(500, 400)];
+	ETLayoutItemGroup *parent = [self contentSizeItemGroup];
+	ETLayoutItemGroup *child = [self contentSizeItemGroup];
+	ETLayoutItemGroup *otherChild = [self contentSizeItemGroup];
+	ETLayoutItemGroup *grandChild = [self contentSizeItemGroup];
+
+	[root addItem: parent];
+	[parent addItems: @[child, otherChild]];
+	[child addItem: grandChild];
+	[[ETLayoutExecutor sharedInstance] removeAllItems];
+	return @[root, parent, child, otherChild, grandChild];
+}
+
+- (id) init
+{
+	SUPERINIT;
+	executor = [ETLayoutExecutor new];
+
+	NSArray *tree = [self itemTree];
+
+	rootItem = tree[0];
+	parentItem = tree[1];
+	childItem = tree[2];
+	otherChildItem = tree[3];
+	grandChildItem = tree[4];
+	return self;
+}
+
+- (void) checkQueue: (NSArray *)queue containsParent: (id)parent afterChild: (id)child
+{
+	UKTrue([queue indexOfObject: child] < [queue indexOfObject: parent]);
+}
+
+/* Checks the queue contains the same items than the queue computed by the 
+previous -executeWithDirtyItems:, and respects the same child before parent 
+constraints. */
+- (void) checkQueueMatchesPreviousQueueForDirtyItems: (NSSet *)scheduledItems
+{
+	NSMutableSet *nonFlexibleItems = [NSMutableSet set];
+	NSMutableSet *previousNonFlexibleItems = [NSMutableSet set];
+	NSArray *queue = [executor flexibleItemQueueForDirtyItems: scheduledItems
+	                                         nonFlexibleItems: nonFlexibleItems];
+	NSArray *previousQueue = [executor previousFlexibleItemQueueForDirtyItems: scheduledItems
+	                                                         nonFlexibleItems: previousNonFlexibleItems];
+
+	UKObjectsEqual(SA(previousQueue), SA(queue));
+	UKIntsEqual([previousQueue count], [queue count]);
+	UKObjectsEqual(previousNonFlexibleItems, nonFlexibleItems);
+
+	for (ETLayoutItemGroup *item in previousQueue)
+	{
+		if ([previousQueue containsObject: [item parentItem]] == NO)
+			continue;
+
+		[self checkQueue: previousQueue containsParent: [item parentItem] afterChild: item];
+		[self checkQueue: queue containsParent: [item parentItem] afterChild: item];
+	}
+
+	/* The order doesn't depend on the set enumeration order */
+	UKObjectsEqual(queue, [executor flexibleItemQueueForDirtyItems: scheduledItems
+	                                              nonFlexibleItems: [NSMutableSet set]]);
+}
+
+- (void) testFlexibleItemQueueMatchesPreviousQueue
+{
+	[self checkQueueMatchesPreviousQueueForDirtyItems: S(grandChildItem)];
+	[self checkQueueMatchesPreviousQueueForDirtyItems: S(parentItem, childItem)];
+	[self checkQueueMatchesPreviousQueueForDirtyItems: S(parentItem, grandChildItem, otherChildItem)];
+	[self checkQueueMatchesPreviousQueueForDirtyItems: S(rootItem, childItem, otherChildItem, grandChildItem)];
+}
+
+- (void) testFlexibleItemQueueOrder
+{
+	NSMutableSet *nonFlexibleItems = [NSMutableSet set];
+	NSArray *queue = [executor flexibleItemQueueForDirtyItems: S(parentItem, grandChildItem, otherChildItem)
+	                                         nonFlexibleItems: nonFlexibleItems];
+
+	UKObjectsEqual(S(grandChildItem, childItem, otherChildItem, parentItem), SA(queue));
+	UKIntsEqual(4, [queue count]);
+	UKObjectsEqual(S(rootItem), nonFlexibleItems);
+
+	[self checkQueue: queue containsParent: childItem afterChild: grandChildItem];
+	[self checkQueue: queue containsParent: parentItem afterChild: childItem];
+	[self checkQueue: queue containsParent: parentItem afterChild: otherChildItem];
+}
+
+- (void) testFlexibleItemQueueForProcessedParentItem
+{
+	NSMutableSet *nonFlexibleItems = [NSMutableSet set];
+	NSArray *queue = [executor flexibleItemQueueForDirtyItems: S(parentItem, childItem)
+	                                         nonFlexibleItems: nonFlexibleItems];
+
+	UKObjectsEqual(A(childItem, parentItem), queue);
+	UKObjectsEqual(S(rootItem), nonFlexibleItems);
+}
+
+- (void) testExecuteMatchesPreviousExecution
+{
+	NSArray *previousTree = [self itemTree];
+	NSSet *previousDirtyItems = S(previousTree[4], previousTree[3]);
+	NSMutableSet *previousNonFlexibleItems = [NSMutableSet set];
+
+	[[grandChildItem firstItem] setWidth: 200];
+	[[previousTree[4] firstItem] setWidth: 200];
+	[[ETLayoutExecutor sharedInstance] removeAllItems];
+
+	[executor addItem: grandChildItem];
+	[executor addItem: otherChildItem];
+	[executor execute];
+
+	NSArray *previousQueue = [executor previousFlexibleItemQueueForDirtyItems: previousDirtyItems
+	                                                         nonFlexibleItems: previousNonFlexibleItems];
+
+	[[previousQueue mappedCollection] updateLayoutRecursively: NO];
+	[[previousNonFlexibleItems mappedCollection] updateLayoutRecursively: NO];
+
+	UKTrue([executor isEmpty]);
+	UKRectsEqual([previousTree[1] frame], [parentItem frame]);
+	UKRectsEqual([previousTree[2] frame], [childItem frame]);
+	UKRectsEqual([previousTree[3] frame], [otherChildItem frame]);
+	UKRectsEqual([previousTree[4] frame], [grandChildItem frame]);
+	UKTrue([parentItem width] >= 200);
+}
+
+- (void) testTraceExecute
+{
+	ETLayoutTracer *tracer = [ETLayoutTracer sharedInstance];
+
+	[tracer removeAllEvents];
+	[tracer setEnabled: YES];
+
+	[executor addItem: grandChildItem];
+	[executor execute];
+
+	[tracer setEnabled: NO];
+
+	NSArray *events = [tracer events];
+	NSArray *categories = [events valueForKey: @"cat"];
+	NSDictionary *passEvent = [events lastObject];
+	NSDictionary *childEvent = [events filteredArrayUsingPredicate:
+		[NSPredicate predicateWithFormat: @"cat == 'layoutUpdate' AND args.itemCount == 2 AND args.reason == 'childFrameChanged'"]].firstObject;
+
+	UKObjectsEqual(@"layoutExecutor", passEvent[@"cat"]);
+	UKIntsEqual(1, [passEvent[@"args"][@"scheduledItemCount"] integerValue]);
+	UKTrue([categories containsObject: @"render"]);
+	UKNotNil(childEvent);
+	UKNotNil([NSJSONSerialization JSONObjectWithData: [tracer traceData] options: 0 error: NULL][@"traceEvents"]);
+
+	[executor addItem: grandChildItem];
+	[executor execute];
+
+	UKIntsEqual([events count], [[tracer events] count]);
+	[tracer removeAllEvents];
+}
+
+@end
+
+
+/* Indents each line more than the previous one, to check hit test doesn't 
+assume the lines share the same 'x' origin. */
+@interface ETFlowLayout (Private)
+- (NSPoint) nextOriginAfterFragment: (id)line 
+                             margin: (CGFloat)itemMargin 
+                          isFlipped: (BOOL)isFlipped;
+@end
+
+@interface TestIndentedFlowLayout : ETFlowLayout
+@end
+
+@implementation TestIndentedFlowLayout
+
+- (NSPoint) nextOriginAfterFragment: (id)line 
+                             margin: (CGFloat)itemMargin 
+                          isFlipped: (BOOL)isFlipped
+{
+	NSPoint nextOrigin =
+		[super nextOriginAfterFragment: line margin: itemMargin isFlipped: isFlipped];
+
+	nextOrigin.x += 15;
+	return nextOrigin;
+}
+
+@end
+
+
+@interface TestComputedLayoutHitTest : TestCommon <UKTest>
+{
+	ETLayoutItemGroup *itemGroup;
+}
+
+@end
+
+@implementation TestComputedLayoutHitTest
+
+- (id) init
+{
+	SUPERINIT;
+	itemGroup = [itemFactory itemGroupWithSize: NSMakeSize(300, 400)];
+
+	for (int i = 0; i < 20; i++)
+	{
+		[itemGroup addItem: [self basicItemWithRect: NSMakeRect(0, 0, 30 + (i % 3) * 10, 20 + (i % 4) * 5)]];
+	}
+	return self;
+}
+
+/* Returns the item that -[ETLayout itemAtLocation:] would find by testing 
+every visible item. */
+- (ETLayoutItem *) scannedItemAtLocation: (NSPoint)location
+{
+	for (ETLayoutItem *item in [itemGroup visibleItems])
+	{
+		if (NSPointInRect(location, [item frame]))
+			return item;
+	}
+	return nil;
+}
+
+- (void) checkHitTestMatchesScanForLayout: (ETLayout *)layout
+{
+	[itemGroup setLayout: layout];
+	[itemGroup updateLayoutRecursively: YES];
+
+	BOOL matchesScan = YES;
+	NSUInteger hitCount = 0;
+
+	for (CGFloat y = -10; y < 410; y += 3)
+	{
+		for (CGFloat x = -10; x < 310; x += 3)
+		{
+			NSPoint location = NSMakePoint(x, y);
+			ETLayoutItem *hitItem = [layout itemAtLocation: location];
+
+			matchesScan = (matchesScan && hitItem == [self scannedItemAtLocation: location]);
+			hitCount += (hitItem != nil);
+		}
+	}
+
+	UKTrue(matchesScan);
+	UKTrue(hitCount > 0);
+}
+
+- (void) testFlowLayout
+{
+	[self checkHitTestMatchesScanForLayout:
+		[ETFlowLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]]];
+}
+
+- (void) testFlowLayoutInNonFlippedContext
+{
+	[itemGroup setFlipped: NO];
+	[self testFlowLayout];
+}
+
+- (void) testFlowLayoutWithGrid
+{
+	ETFlowLayout *layout = [ETFlowLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[layout setUsesGrid: YES];
+	[self checkHitTestMatchesScanForLayout: layout];
+
+	ETLayoutItem *lastItem = [itemGroup lastItem];
+	NSPoint lastItemCenter = NSMakePoint(NSMidX([lastItem frame]), NSMidY([lastItem frame]));
+
+	UKObjectsEqual(lastItem, [layout itemAtLocation: lastItemCenter]);
+}
+
+- (void) testFlowLayoutWithGridInNonFlippedContext
+{
+	[itemGroup setFlipped: NO];
+	[self testFlowLayoutWithGrid];
+}
+
+- (void) testFlowLayoutWithGridAfterRemoval
+{
+	ETFlowLayout *layout = [ETFlowLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[layout setUsesGrid: YES];
+	[self checkHitTestMatchesScanForLayout: layout];
+
+	ETLayoutItem *lastItem = [itemGroup lastItem];
+	NSPoint lastItemCenter = NSMakePoint(NSMidX([lastItem frame]), NSMidY([lastItem frame]));
+
+	[itemGroup removeItem: lastItem];
+
+	UKNil([layout itemAtLocation: lastItemCenter]);
+}
+
+- (void) testFlowLayoutWithGridAndIndentedLines
+{
+	ETFlowLayout *layout =
+		[TestIndentedFlowLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[layout setUsesGrid: YES];
+	[self checkHitTestMatchesScanForLayout: layout];
+
+	ETLayoutItem *lastItem = [itemGroup lastItem];
+	NSPoint lastItemCenter = NSMakePoint(NSMidX([lastItem frame]), NSMidY([lastItem frame]));
+
+	UKTrue(NSMinX([lastItem frame]) > NSMinX([[itemGroup firstItem] frame]));
+	UKObjectsEqual(lastItem, [layout itemAtLocation: lastItemCenter]);
+}
+
+- (void) testFlowLayoutReflow
+{
+	ETFlowLayout *layout = [ETFlowLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[itemGroup setLayout: layout];
+	[itemGroup updateLayoutRecursively: YES];
+
+	NSArray *items = [itemGroup items];
+	NSArray *lines = [layout generateFragmentsForItems: items];
+	ETLayoutItem *resizedItem = items[12];
+
+	UKTrue([lines count] > 3);
+
+	[resizedItem setWidth: [resizedItem width] + 40];
+
+	NSArray *reflowedLines = [layout generateFragmentsForItems: items];
+
+	UKObjectsSame(lines[0], reflowedLines[0]);
+	UKObjectsSame(lines[1], reflowedLines[1]);
+	UKObjectsNotSame(lines[2], reflowedLines[2]);
+
+	/* A removal discards the previous lines */
+	[itemGroup removeItem: [itemGroup lastItem]];
+
+	NSArray *remainingItems = [itemGroup items];
+	NSArray *rebrokenLines = [layout generateFragmentsForItems: remainingItems];
+
+	UKObjectsNotSame(reflowedLines[0], rebrokenLines[0]);
+
+	[itemGroup updateLayoutRecursively: YES];
+
+	NSArray *frames = [[itemGroup items] valueForKey: @"frame"];
+
+	[itemGroup setLayout: [ETFlowLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]]];
+	[itemGroup updateLayoutRecursively: YES];
+
+	UKObjectsEqual(frames, [[itemGroup items] valueForKey: @"frame"]);
+}
+
+- (void) testMemoizedLayout
+{
+	[itemGroup setLayout: [ETFlowLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]]];
+	[itemGroup updateLayoutRecursively: YES];
+
+	NSArray *frames = [[itemGroup items] valueForKey: @"frame"];
+	ETLayoutItem *movedItem = [itemGroup itemAtIndex: 3];
+
+	[movedItem setOrigin: NSMakePoint(500, 500)];
+	[itemGroup updateLayoutRecursively: YES];
+
+	UKObjectsEqual(frames, [[itemGroup items] valueForKey: @"frame"]);
+
+	[[itemGroup firstItem] setDefaultFrame: NSMakeRect(0, 0, 80, 20)];
+	[itemGroup updateLayoutRecursively: YES];
+
+	NSArray *resizedFrames = [[itemGroup items] valueForKey: @"frame"];
+
+	UKObjectsNotEqual(frames, resizedFrames);
+
+	[itemGroup setLayout: [ETFlowLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]]];
+	[itemGroup updateLayoutRecursively: YES];
+
+	UKObjectsEqual(resizedFrames, [[itemGroup items] valueForKey: @"frame"]);
+}
+
+- (void) testMemoizedLayoutWithFlexibleItem
+{
+	ETLayoutItemGroup *lineGroup = [itemFactory itemGroupWithSize: NSMakeSize(300, 100)];
+	ETLayoutItem *item = [self basicItemWithRect: NSMakeRect(0, 0, 50, 20)];
+
+	[lineGroup addItems: @[item, [self basicItemWithRect: NSMakeRect(0, 0, 50, 20)]]];
+	[lineGroup setLayout: [ETLineLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]]];
+	[lineGroup updateLayoutRecursively: YES];
+
+	UKIntsEqual(50, [item width]);
+
+	[item setAutoresizingMask: ETAutoresizingFlexibleWidth];
+	[lineGroup updateLayoutRecursively: YES];
+
+	UKTrue([item width] > 50);
+}
+
+- (void) testSeparatorItemReuse
+{
+	ETColumnLayout *layout = [ETColumnLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[layout setSeparatorTemplateItem: [itemFactory lineSeparator]];
+	[itemGroup setLayout: layout];
+	[itemGroup updateLayoutRecursively: YES];
+
+	NSArray *separators = [[layout layerItem] items];
+
+	UKIntsEqual(19, [separators count]);
+
+	ETLayoutItem *lastItem = [itemGroup lastItem];
+
+	[itemGroup removeItem: lastItem];
+	[itemGroup updateLayoutRecursively: YES];
+
+	UKObjectsEqual([separators subarrayWithRange: NSMakeRange(0, 18)], [[layout layerItem] items]);
+
+	[itemGroup addItem: lastItem];
+	[itemGroup addItem: [self basicItemWithRect: NSMakeRect(0, 0, 30, 20)]];
+	[itemGroup updateLayoutRecursively: YES];
+
+	NSArray *newSeparators = [[layout layerItem] items];
+
+	UKIntsEqual(20, [newSeparators count]);
+	UKObjectsEqual(separators, [newSeparators subarrayWithRange: NSMakeRange(0, 19)]);
+}
+
+- (void) testLineLayout
+{
+	[itemGroup setSize: NSMakeSize(1200, 100)];
+	[self checkHitTestMatchesScanForLayout:
+		[ETLineLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]]];
+}
+
+- (void) testColumnLayout
+{
+	[self checkHitTestMatchesScanForLayout:
+		[ETColumnLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]]];
+}
+
+- (void) testColumnLayoutInNonFlippedContext
+{
+	[itemGroup setFlipped: NO];
+	[self testColumnLayout];
+}
+
+- (void) testHiddenItem
+{
+	ETLayout *layout = [ETColumnLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+	ETLayoutItem *firstItem = [itemGroup firstItem];
+
+	[itemGroup setLayout: layout];
+	[itemGroup updateLayoutRecursively: YES];
+
+	NSPoint center = NSMakePoint(NSMidX([firstItem frame]), NSMidY([firstItem frame]));
+
+	UKObjectsEqual(firstItem, [layout itemAtLocation: center]);
+
+	[firstItem setHidden: YES];
+
+	UKNil([layout itemAtLocation: center]);
+}
+
+@end
+
+
+@interface TestComputedLayoutVirtualization : TestCommon <UKTest>
+{
+	ETLayoutItemGroup *itemGroup;
+	ETColumnLayout *layout;
+}
+
+@end
+
+@implementation TestComputedLayoutVirtualization
+
+- (id) init
+{
+	SUPERINIT;
+	itemGroup = [itemFactory itemGroupWithSize: NSMakeSize(200, 100)];
+	layout = [ETColumnLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	for (int i = 0; i < 100; i++)
+	{
+		[itemGroup addItem: [self basicItemWithRect: NSMakeRect(0, 0, 50, 20)]];
+	}
+
+	[itemGroup setHasVerticalScroller: YES];
+	[itemGroup setLayout: layout];
+	[layout setVirtualizationMargin: 0];
+	return self;
+}
+
+- (void) testAllItemsExposedWithoutVirtualization
+{
+	[itemGroup updateLayoutRecursively: YES];
+
+	UKIntsEqual(100, [[itemGroup exposedItems] count]);
+	UKTrue(ETIsNullRect([layout exposedRect]));
+}
+
+- (void) testExposedItemsForVisibleRect
+{
+	[layout setVirtualizesItems: YES];
+	[itemGroup updateLayoutRecursively: YES];
+
+	NSRect exposedRect = [layout exposedRect];
+
+	UKFalse(ETIsNullRect(exposedRect));
+	UKTrue([[itemGroup exposedItems] count] < 100);
+	UKTrue([[itemGroup firstItem] isExposed]);
+	UKFalse([[itemGroup lastItem] isExposed]);
+
+	for (ETLayoutItem *item in [itemGroup items])
+	{
+		UKTrue([item isExposed] == NSIntersectsRect(exposedRect, [item frame]));
+	}
+}
+
+- (void) testExposedItemsAfterScrolling
+{
+	[layout setVirtualizesItems: YES];
+	[itemGroup updateLayoutRecursively: YES];
+
+	NSScrollView *scrollView = [[itemGroup scrollableAreaItem] scrollView];
+	NSRect lastItemFrame = [[itemGroup lastItem] frame];
+
+	[[scrollView contentView] scrollToPoint: lastItemFrame.origin];
+	[scrollView reflectScrolledClipView: [scrollView contentView]];
+
+	UKTrue([[itemGroup lastItem] isExposed]);
+	UKFalse([[itemGroup firstItem] isExposed]);
+}
+
+- (void) testExposedItemsAcrossFlowLines
+{
+	ETFlowLayout *flowLayout =
+		[ETFlowLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[itemGroup setLayout: flowLayout];
+	[flowLayout setVirtualizationMargin: 0];
+	[flowLayout setVirtualizesItems: YES];
+	[itemGroup updateLayoutRecursively: YES];
+
+	NSScrollView *scrollView = [[itemGroup scrollableAreaItem] scrollView];
+	NSRect middleItemFrame = [[itemGroup itemAtIndex: 50] frame];
+
+	[[scrollView contentView] scrollToPoint: middleItemFrame.origin];
+	[scrollView reflectScrolledClipView: [scrollView contentView]];
+
+	NSRect exposedRect = [flowLayout exposedRect];
+
+	UKTrue([[itemGroup itemAtIndex: 50] isExposed]);
+	UKFalse([[itemGroup firstItem] isExposed]);
+	UKFalse([[itemGroup lastItem] isExposed]);
+
+	for (ETLayoutItem *item in [itemGroup items])
+	{
+		UKTrue([item isExposed] == NSIntersectsRect(exposedRect, [item frame]));
+	}
+}
+
+@end
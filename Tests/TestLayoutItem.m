@@ -12,6 +12,7 @@
 #import "ETController.h"
 #import "ETDecoratorItem.h"
 #import "ETGeometry.h"
+#import "ETImageLoader.h"
 #import "ETLayoutItem.h"
 #import "ETLayoutItemFactory.h"
 #import "ETLayoutExecutor.h"
@@ -20,6 +21,7 @@
 #import "ETLayoutExecutor.h"
 #import "ETFlowLayout.h"
 #import "ETScrollableAreaItem.h"
+#import "ETSpatialIndex.h"
 #import "ETTableLayout.h"
 #import "ETView.h"
 #import "ETCompatibility.h"
@@ -145,6 +147,63 @@
 	UKNil(item.supervisorView.superview);
 }
 
+- (void) testExposeItemsWithViews
+{
+	ETLayoutItem *item1 = [itemFactory itemWithView: [NSView new]];
+	ETLayoutItem *item2 = [itemFactory itemWithView: [NSView new]];
+	ETLayoutItem *item3 = [itemFactory itemWithView: [NSView new]];
+	ETLayoutItemGroup *parentItem = [itemFactory itemGroupWithItems: @[item1, item2, item3]];
+
+	parentItem.exposedItems = @[item3, item1];
+
+	UKObjectsEqual(A(item1, item3), parentItem.exposedItems);
+	UKFalse(item2.isExposed);
+	UKObjectsEqual(A(item1.supervisorView, item3.supervisorView), parentItem.supervisorView.itemViews);
+
+	parentItem.exposedItems = @[item1, item2, item3];
+
+	UKObjectsEqual(A(item1, item2, item3), parentItem.exposedItems);
+	UKObjectsEqual(A(item1.supervisorView, item2.supervisorView, item3.supervisorView),
+		parentItem.supervisorView.itemViews);
+
+	NSArray *subviews = parentItem.supervisorView.subviews;
+
+	parentItem.exposedItems = @[item1, item2, item3];
+
+	UKObjectsEqual(subviews, parentItem.supervisorView.subviews);
+
+	parentItem.exposedItems = @[item2];
+
+	UKObjectsEqual(A(item2.supervisorView), parentItem.supervisorView.itemViews);
+	UKNil(item1.supervisorView.superview);
+	UKNil(item3.supervisorView.superview);
+}
+
+- (void) testExposeInsertedAndRemovedItemsWithViews
+{
+	ETLayoutItem *item1 = [itemFactory itemWithView: [NSView new]];
+	ETLayoutItem *item2 = [itemFactory itemWithView: [NSView new]];
+	ETLayoutItem *item3 = [itemFactory itemWithView: [NSView new]];
+	ETLayoutItemGroup *parentItem = [itemFactory itemGroupWithItems: @[item1, item3]];
+
+	parentItem.exposedItems = @[item1, item3];
+	[parentItem insertItem: item2 atIndex: 1];
+	parentItem.exposedItems = @[item1, item2, item3];
+
+	UKObjectsEqual(A(item1.supervisorView, item2.supervisorView, item3.supervisorView),
+		parentItem.supervisorView.itemViews);
+
+	[parentItem removeItem: item1];
+
+	UKFalse(item1.isExposed);
+	UKNil(item1.supervisorView.superview);
+	UKObjectsEqual(A(item2.supervisorView, item3.supervisorView), parentItem.supervisorView.itemViews);
+
+	parentItem.exposedItems = @[];
+
+	UKTrue(parentItem.supervisorView.itemViews.isEmpty);
+}
+
 - (void) testAddAndRemoveItem
 {
 	// TODO: Test when the item has a parent item already
@@ -301,6 +360,29 @@
 	UKTrue([itemGroup indexOfItem: item] == NSNotFound);
 }
 
+- (void) testIndexOfItemAfterMutations
+{
+	ETLayoutItem *item0 = [itemFactory item];
+	ETLayoutItem *item1 = [itemFactory item];
+	ETLayoutItem *item2 = [itemFactory item];
+	ETLayoutItem *insertedItem = [itemFactory item];
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroupWithItems: A(item0, item1, item2)];
+
+	UKIntsEqual(2, [itemGroup indexOfItem: item2]);
+
+	[itemGroup insertItem: insertedItem atIndex: 0];
+
+	UKIntsEqual(0, [itemGroup indexOfItem: insertedItem]);
+	UKIntsEqual(1, [itemGroup indexOfItem: item0]);
+	UKIntsEqual(3, [itemGroup indexOfItem: item2]);
+
+	[itemGroup removeItem: item0];
+
+	UKIntsEqual(1, [itemGroup indexOfItem: item1]);
+	UKIntsEqual(2, [itemGroup indexOfItem: item2]);
+	UKTrue([itemGroup indexOfItem: item0] == NSNotFound);
+}
+
 - (void) testIndexPathForItem
 {
 	id item = [itemFactory itemGroup];
@@ -496,6 +578,42 @@
 	UKNil([[parent supervisorView] wrappedView]);
 }
 
+- (void) testImageLoader
+{
+	NSBitmapImageRep *rep =
+		[[NSBitmapImageRep alloc] initWithBitmapDataPlanes: NULL
+		                                        pixelsWide: 64
+		                                        pixelsHigh: 32
+		                                     bitsPerSample: 8
+		                                   samplesPerPixel: 4
+		                                          hasAlpha: YES
+		                                          isPlanar: NO
+		                                    colorSpaceName: NSDeviceRGBColorSpace
+		                                       bytesPerRow: 0
+		                                      bitsPerPixel: 0];
+	NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent: @"TestImageLoader.png"];
+
+	[[rep representationUsingType: NSPNGFileType properties: @{}] writeToFile: path atomically: YES];
+
+	ETImageLoader *loader = [[ETImageLoader alloc] init];
+	NSImage *placeholder = [[NSImage alloc] initWithSize: NSMakeSize(16, 16)];
+	ETLayoutItem *item = [itemFactory item];
+
+	[loader setPlaceholderImage: placeholder];
+	[loader setMaxImageSize: NSMakeSize(16, 16)];
+	[loader loadImageAtPath: path forItem: item];
+
+	UKObjectsSame(placeholder, [item image]);
+	UKTrue([loader isLoadingForItem: item]);
+
+	[loader waitUntilAllImagesAreLoaded];
+
+	UKFalse([loader isLoadingForItem: item]);
+	UKSizesEqual(NSMakeSize(16, 8), [[item image] size]);
+
+	[[NSFileManager defaultManager] removeItemAtPath: path error: NULL];
+}
+
 @end
 
 #import "ETTableLayout.h"
@@ -662,4 +780,144 @@
 	UKTrue([selectedItems containsObject: item2]);
 }
 
+- (void) testSelectionForMutation
+{
+	BUILD_SELECTION_TEST_TREE_item_0_10_110
+
+	[item removeItem: item1];
+
+	UKObjectsEqual(A([item0 indexPath]), [item selectionIndexPaths]);
+
+	[item0 addItem: item1];
+
+	NSArray *indexPaths = A([item0 indexPath], [item10 indexPathFromItem: item], 
+		[item110 indexPathFromItem: item]);
+
+	UKObjectsEqual(indexPaths, [item selectionIndexPaths]);
+
+	[item0 insertItem: [itemFactory item] atIndex: 0];
+
+	UKObjectsEqual(A(item0), [item selectedItems]);
+	UKObjectsEqual([[[NSIndexPath indexPathWithIndex: 0] indexPathByAddingIndex: 3] indexPathByAddingIndex: 0],
+		[[item selectionIndexPaths] objectAtIndex: 1]);
+}
+
+- (void) testSetSelectionIndexPathsPostsOneNotificationPerItemGroup
+{
+	BUILD_TEST_TREE
+
+	__block NSUInteger nbOfNotifications = 0;
+	id observer = [[NSNotificationCenter defaultCenter]
+		addObserverForName: ETItemGroupSelectionDidChangeNotification
+		            object: item1
+		             queue: nil
+		        usingBlock: ^(NSNotification *notif) { nbOfNotifications++; }];
+
+	[item setSelectionIndexPaths: A([item10 indexPathFromItem: item], 
+		[item11 indexPathFromItem: item], [item110 indexPathFromItem: item])];
+	[[NSNotificationCenter defaultCenter] removeObserver: observer];
+
+	UKIntsEqual(1, nbOfNotifications);
+	UKObjectsEqual(A(item10, item11), [item1 selectedItems]);
+}
+
+- (void) testSpatialIndex
+{
+	ETLayoutItem *item0 = [self basicItemWithRect: NSMakeRect(0, 0, 50, 50)];
+	ETLayoutItem *item1 = [self basicItemWithRect: NSMakeRect(1000, 1000, 50, 50)];
+	ETLayoutItem *item2 = [self basicItemWithRect: NSMakeRect(20, 20, 50, 50)];
+
+	[item setUsesSpatialIndex: YES];
+	[item addItems: @[item0, item1, item2]];
+
+	UKTrue([item usesSpatialIndex]);
+	UKIntsEqual(3, [[item spatialIndex] count]);
+	UKObjectsEqual(A(item2, item0), [[item spatialIndex] itemsIntersectingRect: NSMakeRect(0, 0, 100, 100)]);
+	UKObjectsEqual(A(item1), [[item spatialIndex] itemsIntersectingRect: NSMakeRect(900, 900, 200, 200)]);
+	UKTrue([[[item spatialIndex] itemsIntersectingRect: NSMakeRect(500, 500, 10, 10)] isEmpty]);
+}
+
+- (void) testSpatialIndexUpdateForGeometryChange
+{
+	ETLayoutItem *item0 = [self basicItemWithRect: NSMakeRect(0, 0, 50, 50)];
+
+	[item setUsesSpatialIndex: YES];
+	[item addItem: item0];
+
+	UKObjectsEqual(A(item0), [[item spatialIndex] itemsIntersectingRect: NSMakeRect(0, 0, 10, 10)]);
+
+	[item0 setOrigin: NSMakePoint(2000, 2000)];
+
+	UKRectsEqual([item0 frame], [[item spatialIndex] rectForItem: item0]);
+	UKTrue([[[item spatialIndex] itemsIntersectingRect: NSMakeRect(0, 0, 10, 10)] isEmpty]);
+	UKObjectsEqual(A(item0), [[item spatialIndex] itemsIntersectingRect: NSMakeRect(2000, 2000, 10, 10)]);
+
+	[item0 setSize: NSMakeSize(600, 600)];
+
+	UKObjectsEqual(A(item0), [[item spatialIndex] itemsIntersectingRect: NSMakeRect(2550, 2550, 10, 10)]);
+}
+
+- (void) testSpatialIndexUpdateForMutation
+{
+	ETLayoutItem *item0 = [self basicItemWithRect: NSMakeRect(0, 0, 50, 50)];
+	ETLayoutItem *item1 = [self basicItemWithRect: NSMakeRect(10, 10, 50, 50)];
+
+	[item setUsesSpatialIndex: YES];
+	[item addItem: item0];
+
+	UKIntsEqual(1, [[item spatialIndex] count]);
+
+	[item insertItem: item1 atIndex: 0];
+
+	UKObjectsEqual(A(item0, item1), [[item spatialIndex] itemsIntersectingRect: NSMakeRect(0, 0, 20, 20)]);
+
+	[item removeItem: item0];
+
+	UKObjectsEqual(A(item1), [[item spatialIndex] itemsIntersectingRect: NSMakeRect(0, 0, 20, 20)]);
+	UKFalse([[item spatialIndex] containsItem: item0]);
+
+	[item setUsesSpatialIndex: NO];
+
+	UKNil([item spatialIndex]);
+}
+
+- (void) testSpatialIndexForHugeAndNonFiniteRects
+{
+	ETSpatialIndex *index = [ETSpatialIndex new];
+	ETLayoutItem *hugeItem = [itemFactory item];
+	ETLayoutItem *infiniteItem = [itemFactory item];
+	ETLayoutItem *farItem = [itemFactory item];
+	ETLayoutItem *smallItem = [itemFactory item];
+
+	[index setRect: NSMakeRect(-1e9, -1e9, 2e9, 2e9) order: 0 forItem: hugeItem];
+	[index setRect: NSMakeRect(0, 0, INFINITY, INFINITY) order: 1 forItem: infiniteItem];
+	[index setRect: NSMakeRect(1e30, 1e30, 10, 10) order: 2 forItem: farItem];
+	[index setRect: NSMakeRect(0, 0, 10, 10) order: 3 forItem: smallItem];
+
+	UKObjectsEqual(A(smallItem, infiniteItem, hugeItem), [index itemsIntersectingRect: NSMakeRect(5, 5, 10, 10)]);
+	UKObjectsEqual(A(farItem), [index itemsIntersectingRect: NSMakeRect(1e30, 1e30, 20, 20)]);
+	UKIntsEqual(4, [[index itemsIntersectingRect: NSMakeRect(-1e35, -1e35, 2e35, 2e35)] count]);
+
+	[index setRect: NSMakeRect(500, 500, 10, 10) forItem: hugeItem];
+	[index removeItem: infiniteItem];
+
+	UKObjectsEqual(A(smallItem), [index itemsIntersectingRect: NSMakeRect(5, 5, 10, 10)]);
+	UKObjectsEqual(A(hugeItem), [index itemsIntersectingRect: NSMakeRect(505, 505, 10, 10)]);
+	UKIntsEqual(3, [index count]);
+}
+
+- (void) testSpatialIndexCopy
+{
+	ETLayoutItem *item0 = [self basicItemWithRect: NSMakeRect(0, 0, 50, 50)];
+
+	[item setUsesSpatialIndex: YES];
+	[item addItem: item0];
+
+	ETLayoutItemGroup *newItem = [item copy];
+
+	UKTrue([newItem usesSpatialIndex]);
+	UKIntsEqual(1, [[newItem spatialIndex] count]);
+	UKObjectsEqual(A([newItem firstItem]), [[newItem spatialIndex] itemsIntersectingRect: NSMakeRect(0, 0, 10, 10)]);
+}
+
 @end
@@ -6,11 +6,17 @@
     License:  Modified BSD (see COPYING)
  */
 
+#import <EtoileFoundation/ETMutableObjectViewpoint.h>
 #import "TestCommon.h"
 #import "ETBasicItemStyle.h"
 #import "ETLayoutExecutor.h"
 #import "ETLayoutItem.h"
 #import "ETLayoutItemFactory.h"
+#import "ETLayoutItemGroup.h"
+#import "ETRenderContext.h"
+#import "ETStyleGroup.h"
+#import "ETTextMetricsCache.h"
+#import "ETThumbnailCache.h"
 #import "ETCompatibility.h"
 
 @interface TestStyle: TestCommon <UKTest>
@@ -54,6 +60,324 @@
 	UKRectsEqual(NSMakeRect(75, 40, 150, 20), viewRect); 
 }
 
+- (void) testTextMetricsCache
+{
+	ETTextMetricsCache *cache = [[ETTextMetricsCache alloc] initWithCapacity: 2];
+	NSDictionary *attributes = [ETBasicItemStyle standardLabelAttributes];
+
+	UKSizesEqual([@"Elephant" sizeWithAttributes: attributes],
+		[cache sizeOfString: @"Elephant" withAttributes: attributes]);
+	[cache sizeOfString: @"Tiger" withAttributes: attributes];
+	[cache sizeOfString: @"Elephant" withAttributes: [attributes copy]];
+
+	UKIntsEqual(2, [cache count]);
+	UKIntsEqual(1, [cache hitCount]);
+	UKIntsEqual(2, [cache missCount]);
+
+	/* Tiger is the least recently used size */
+	[cache sizeOfString: @"Zebra" withAttributes: attributes];
+	[cache sizeOfString: @"Elephant" withAttributes: attributes];
+
+	UKIntsEqual(2, [cache count]);
+	UKIntsEqual(2, [cache hitCount]);
+	UKIntsEqual(3, [cache missCount]);
+
+	[cache sizeOfString: @"Tiger" withAttributes: attributes];
+
+	UKIntsEqual(4, [cache missCount]);
+
+	[cache removeAllSizes];
+
+	UKIntsEqual(0, [cache count]);
+
+	UKSizesEqual(NSZeroSize, [cache sizeOfString: nil withAttributes: attributes]);
+	UKIntsEqual(0, [cache count]);
+}
+
+- (void) testThumbnailCache
+{
+	ETThumbnailCache *cache = [[ETThumbnailCache alloc] init];
+	NSImage *image = [[NSImage alloc] initWithSize: NSMakeSize(512, 256)];
+
+	[image lockFocus];
+	[[NSColor redColor] set];
+	NSRectFill(NSMakeRect(0, 0, 512, 256));
+	[image unlockFocus];
+
+	NSImage *thumbnail = [cache thumbnailForImage: image fittingPixelSize: NSMakeSize(100, 50)];
+
+	UKSizesEqual(NSMakeSize(128, 64), [thumbnail size]);
+	UKObjectsSame(thumbnail, [cache thumbnailForImage: image fittingPixelSize: NSMakeSize(120, 60)]);
+	UKObjectsSame(image, [cache thumbnailForImage: image fittingPixelSize: NSMakeSize(600, 300)]);
+	UKIntsEqual(1, [cache hitCount]);
+	UKIntsEqual(1, [cache missCount]);
+	UKIntsEqual(128 * 64 * 4, [cache memoryCost]);
+
+	NSImage *smallerThumbnail = [cache thumbnailForImage: image fittingPixelSize: NSMakeSize(30, 15)];
+
+	UKSizesEqual(NSMakeSize(32, 16), [smallerThumbnail size]);
+
+	/* Evicts the least recently used 128 * 64 level */
+	[cache setMaxMemoryCost: 32 * 16 * 4];
+
+	UKIntsEqual(32 * 16 * 4, [cache memoryCost]);
+	UKObjectsSame(smallerThumbnail, [cache thumbnailForImage: image fittingPixelSize: NSMakeSize(30, 15)]);
+	UKObjectsNotSame(thumbnail, [cache thumbnailForImage: image fittingPixelSize: NSMakeSize(100, 50)]);
+}
+
+- (void) testBasicItemStyleScaleFactor
+{
+	ETBasicItemStyle *style = [ETBasicItemStyle styleWithLabelPosition: ETLabelPositionNone
+	                                                objectGraphContext: [itemFactory objectGraphContext]];
+	ETRenderContext *renderContext = [ETRenderContext renderContextWithInputValues: @{}];
+	NSImage *image = [[NSImage alloc] initWithSize: NSMakeSize(100, 100)];
+
+	UKIntsEqual(1, [style currentScaleFactor]);
+
+	[renderContext setScaleFactor: 2];
+	[image lockFocus];
+	[style render: renderContext layoutItem: item dirtyRect: [item bounds]];
+
+	UKIntsEqual(2, [style currentScaleFactor]);
+
+	[style render: nil layoutItem: item dirtyRect: [item bounds]];
+	[image unlockFocus];
+
+	UKIntsEqual(1, [style currentScaleFactor]);
+}
+
+- (void) testRenderState
+{
+	NSAffineTransform *transform = [NSAffineTransform transform];
+
+	[transform translateXBy: 100 yBy: 50];
+	[transform translateXBy: 0 yBy: 200];
+	[transform scaleXBy: 1 yBy: -1];
+
+	ETRenderState state = ETRenderStateMake([item frame], YES, ETNullRect);
+	NSAffineTransform *stateTransform = [NSAffineTransform transform];
+
+	[stateTransform setTransformStruct: state.transform];
+
+	UKPointsEqual([transform transformPoint: NSMakePoint(10, 20)],
+		[stateTransform transformPoint: NSMakePoint(10, 20)]);
+}
+
+- (void) testRenderAllocations
+{
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroup];
+	NSImage *image = [[NSImage alloc] initWithSize: NSMakeSize(500, 400)];
+	NSRect rect = NSMakeRect(10, 20, 50, 30);
+	ETRenderState state = ETRenderStateMake(rect, YES, ETNullRect);
+
+	[itemGroup setSize: [image size]];
+	[itemGroup addItems: @[item, [itemFactory item], [itemFactory item]]];
+
+	[image lockFocus];
+
+	/* Before: a transform and a clip path per child */
+	ETResetRenderStatistics();
+	for (int i = 0; i < 100; i++)
+	{
+		NSAffineTransform *transform = [NSAffineTransform transform];
+
+		[transform translateXBy: rect.origin.x yBy: rect.origin.y + rect.size.height];
+		[transform scaleXBy: 1.0 yBy: -1.0];
+		[transform concat];
+		[[NSBezierPath bezierPathWithRect: rect] setClip];
+		[transform invert];
+		[transform concat];
+	}
+	NSUInteger allocationCountBefore = ETGetRenderStatistics().allocationCount;
+
+	/* After: a render state per child */
+	ETResetRenderStatistics();
+	for (int i = 0; i < 100; i++)
+	{
+		ETPushRenderState(state);
+		ETPopRenderState(state);
+	}
+	NSUInteger allocationCountAfter = ETGetRenderStatistics().allocationCount;
+
+	ETResetRenderStatistics();
+	[itemGroup render: nil dirtyRect: [itemGroup bounds] inContext: nil];
+
+	[image unlockFocus];
+
+	UKTrue(ETGetRenderStatistics().renderStateCount >= [itemGroup numberOfItems]);
+#ifdef GNUSTEP
+	UKTrue(allocationCountBefore >= 200);
+	UKTrue(allocationCountAfter < allocationCountBefore);
+	UKTrue(ETGetRenderStatistics().allocationCount != NSNotFound);
+#else
+	UKIntsEqual(NSNotFound, allocationCountBefore);
+	UKIntsEqual(NSNotFound, allocationCountAfter);
+	UKIntsEqual(NSNotFound, ETGetRenderStatistics().allocationCount);
+#endif
+}
+
+- (void) testRenderContext
+{
+	ETRenderContext *renderContext = [ETRenderContext renderContextWithInputValues: @{ @"hint": @YES }];
+	NSImage *image = [[NSImage alloc] initWithSize: NSMakeSize(500, 400)];
+
+	UKObjectsEqual(@YES, [renderContext objectForKey: @"hint"]);
+	UKObjectsSame(renderContext, [ETRenderContext renderContextWithInputValues: renderContext]);
+	UKTrue([renderContext drawsSelectionIndicator]);
+
+	[image lockFocus];
+	[renderContext pushRenderState: ETRenderStateMake([item frame], NO, NSMakeRect(0, 0, 300, 200))];
+
+	UKRectsEqual(NSMakeRect(0, 0, 300, 200), [renderContext dirtyRect]);
+	UKIntsEqual(100, [renderContext transform].tX);
+	UKIntsEqual(50, [renderContext transform].tY);
+
+	[renderContext pushRenderState: ETRenderStateMake(NSMakeRect(50, 100, 0, 0), NO, ETNullRect)];
+
+	UKRectsEqual(NSMakeRect(-50, -100, 300, 200), [renderContext clipRect]);
+	UKIntsEqual(150, [renderContext transform].tX);
+
+	[renderContext pushRenderState: (ETRenderState){ ETIdentityTransform(), NSMakeRect(0, 0, 400, 400) }];
+
+	UKRectsEqual(NSMakeRect(0, 0, 250, 100), [renderContext clipRect]);
+	UKRectsEqual(NSMakeRect(0, 0, 250, 100), [renderContext dirtyRect]);
+
+	[renderContext popRenderState];
+	[renderContext popRenderState];
+	[renderContext popRenderState];
+	[image unlockFocus];
+
+	UKTrue(ETIsNullRect([renderContext clipRect]));
+	UKIntsEqual(0, [renderContext transform].tX);
+}
+
+- (void) testRenderContextReset
+{
+	NSMutableDictionary *inputValues = [NSMutableDictionary dictionary];
+	ETRenderContext *renderContext = [ETRenderContext renderContextWithInputValues: inputValues];
+
+	[renderContext setObject: @YES forKey: @"hint"];
+
+	UKObjectsSame(inputValues, [renderContext inputValues]);
+	UKObjectsEqual(@YES, inputValues[@"hint"]);
+
+	[renderContext setDrawsSelectionIndicator: NO];
+	[renderContext setDirtyRect: NSMakeRect(0, 0, 10, 10)];
+	[renderContext resetWithInputValues: @{ @"other": @YES }];
+
+	UKTrue([renderContext drawsSelectionIndicator]);
+	UKTrue(ETIsNullRect([renderContext dirtyRect]));
+	UKNil([renderContext objectForKey: @"hint"]);
+	UKObjectsEqual(@YES, [renderContext objectForKey: @"other"]);
+
+	[renderContext resetWithInputValues: nil];
+
+	UKIntsEqual(0, [renderContext count]);
+}
+
+- (void) testRenderContextAsInputValues
+{
+	ETRenderContext *renderContext = [ETRenderContext renderContextWithInputValues: @{ @"hint": @YES }];
+	NSMutableDictionary *inputValues = [NSMutableDictionary dictionaryWithObject: @YES forKey: @"hint"];
+	NSImage *image = [[NSImage alloc] initWithSize: NSMakeSize(500, 400)];
+
+	UKIntsEqual(1, [renderContext count]);
+	UKObjectsEqual(@YES, renderContext[@"hint"]);
+	UKObjectsEqual(A(@"hint"), [[renderContext keyEnumerator] allObjects]);
+
+	for (NSString *key in renderContext)
+	{
+		UKStringsEqual(@"hint", key);
+	}
+
+	[image lockFocus];
+	UKDoesNotRaiseException([[item styleGroup] render: (id)inputValues layoutItem: item dirtyRect: [item bounds]]);
+	[image unlockFocus];
+
+	UKObjectsEqual(@YES, [ETRenderContextFromInputValues(inputValues) objectForKey: @"hint"]);
+	UKNil(ETRenderContextFromInputValues(nil));
+}
+
+- (void) renderItemBackground
+{
+	NSImage *image = [[NSImage alloc] initWithSize: NSMakeSize(500, 400)];
+
+	[image lockFocus];
+	[item renderBackground: nil dirtyRect: [item bounds] inContext: nil];
+	[image unlockFocus];
+}
+
+- (void) testDisplayList
+{
+	ETLayoutItem *observedItem = [itemFactory item];
+
+	[item setName: @"Whatever"];
+	[item setRepresentedObject: [ETMutableObjectViewpoint viewpointWithName: @"name"
+	                                                      representedObject: observedItem]];
+	[item setRecordsDisplayList: YES];
+
+	UKTrue([[item styleGroup] supportsDisplayList]);
+	UKNil([item displayList]);
+
+	ETResetRenderStatistics();
+	[self renderItemBackground];
+
+	UKNotNil([item displayList]);
+	UKTrue([[item displayList] count] > 0);
+	UKIntsEqual(0, ETGetRenderStatistics().displayListHitCount);
+	UKIntsEqual(1, ETGetRenderStatistics().displayListMissCount);
+
+	[self renderItemBackground];
+
+	UKIntsEqual(1, ETGetRenderStatistics().displayListHitCount);
+
+	[item setSelected: YES];
+	[self renderItemBackground];
+
+	UKIntsEqual(2, ETGetRenderStatistics().displayListMissCount);
+
+	[[item style] setLabelPosition: ETLabelPositionInsideTop];
+	[self renderItemBackground];
+
+	UKIntsEqual(3, ETGetRenderStatistics().displayListMissCount);
+
+	[item setSize: NSMakeSize(100, 100)];
+	[self renderItemBackground];
+
+	UKIntsEqual(4, ETGetRenderStatistics().displayListMissCount);
+
+	/* See the represented object change in -[ETLayoutItem observeValueForKeyPath:ofObject:change:context:] */
+	[observedItem setName: @"Something"];
+	[self renderItemBackground];
+
+	UKIntsEqual(5, ETGetRenderStatistics().displayListMissCount);
+	UKIntsEqual(1, ETGetRenderStatistics().displayListHitCount);
+
+	[item setRecordsDisplayList: NO];
+
+	UKNil([item displayList]);
+}
+
+- (void) testStyleGroupDisplayListRevision
+{
+	ETStyle *firstStyle = [[ETStyle alloc] initWithObjectGraphContext: [itemFactory objectGraphContext]];
+	ETStyle *lastStyle = [[ETStyle alloc] initWithObjectGraphContext: [itemFactory objectGraphContext]];
+	ETStyleGroup *styleGroup = [[ETStyleGroup alloc] initWithCollection: @[firstStyle, lastStyle]
+	                                                 objectGraphContext: [itemFactory objectGraphContext]];
+	NSMutableSet *revisions = [NSMutableSet setWithObject: @([styleGroup displayListRevision])];
+
+	[lastStyle incrementDisplayListRevision];
+	[revisions addObject: @([styleGroup displayListRevision])];
+	[firstStyle incrementDisplayListRevision];
+	[revisions addObject: @([styleGroup displayListRevision])];
+	[styleGroup removeStyle: firstStyle];
+	[revisions addObject: @([styleGroup displayListRevision])];
+	[styleGroup addStyle: firstStyle];
+	[revisions addObject: @([styleGroup displayListRevision])];
+
+	UKIntsEqual(5, [revisions count]);
+}
+
 //UKPointsEqual(NSMakePoint(0, [item height]), labelRect.origin);
 
 @end
@@ -15,6 +15,7 @@
 #import "ETLayoutItemGroup.h"
 #import "ETLineLayout.h"
 #import "ETLayoutItemFactory.h"
+#import "ETMoveTool.h"
 #import "ETTool.h"
 #import "ETCompatibility.h"
 
@@ -205,4 +206,53 @@
 	UKRaisesException([[ETSelectTool tool] addItem: nil]);
 }
 
+- (void) testCoalescedDragEventsForTranslation
+{
+	ETMoveTool *moveTool = [ETMoveTool tool];
+	ETLayoutItem *item = [itemFactory rectangleWithRect: NSMakeRect(10, 10, 50, 50)];
+	NSPoint position = [item position];
+
+	[mainItem addItem: item];
+
+	UKTrue([moveTool coalescesDragEvents]);
+
+	[moveTool beginTranslateItem: item atPoint: NSMakePoint(20, 20)];
+	[moveTool mouseDragged: [self createEventAtPoint: NSMakePoint(25, 20) clickCount: 1 inWindow: [self window]]];
+	[moveTool mouseDragged: [self createEventAtPoint: NSMakePoint(30, 15) clickCount: 1 inWindow: [self window]]];
+
+	UKPointsEqual(position, [item position]);
+
+	/* Let the run loop apply the accumulated delta */
+	[[NSRunLoop currentRunLoop] runUntilDate: [NSDate dateWithTimeIntervalSinceNow: 0.01]];
+
+	/* The main item is flipped */
+	UKPointsEqual(NSMakePoint(position.x + 10, position.y + 5), [item position]);
+
+	[moveTool mouseDragged: [self createEventAtPoint: NSMakePoint(35, 15) clickCount: 1 inWindow: [self window]]];
+	[moveTool endTranslate];
+
+	UKPointsEqual(NSMakePoint(position.x + 15, position.y + 5), [item position]);
+
+	[[NSRunLoop currentRunLoop] runUntilDate: [NSDate dateWithTimeIntervalSinceNow: 0.01]];
+
+	UKPointsEqual(NSMakePoint(position.x + 15, position.y + 5), [item position]);
+}
+
+- (void) testUncoalescedDragEventsForTranslation
+{
+	ETMoveTool *moveTool = [ETMoveTool tool];
+	ETLayoutItem *item = [itemFactory rectangleWithRect: NSMakeRect(10, 10, 50, 50)];
+	NSPoint position = [item position];
+
+	[mainItem addItem: item];
+	[moveTool setCoalescesDragEvents: NO];
+
+	[moveTool beginTranslateItem: item atPoint: NSMakePoint(20, 20)];
+	[moveTool mouseDragged: [self createEventAtPoint: NSMakePoint(25, 20) clickCount: 1 inWindow: [self window]]];
+
+	UKPointsEqual(NSMakePoint(position.x + 5, position.y), [item position]);
+
+	[moveTool didBecomeInactive];
+}
+
 @end
@@ -9,8 +9,23 @@
 #import "TestCommon.h"
 #import "ETWidgetLayout.h"
 #import "ETTableLayout.h"
+#import "ETLayoutItem+Private.h"
+#import "ETLayoutItemGroup+Mutation.h"
 #import "ETCompatibility.h"
 
+@interface ETTableLayout (TestWidgetLayout)
+@property (nonatomic, readonly) NSUInteger cachedItemCount;
+@end
+
+@implementation ETTableLayout (TestWidgetLayout)
+
+- (NSUInteger) cachedItemCount
+{
+	return [_cachedValues count]; /* Private ivar tested in -testCachedObjectValuesLimit */
+}
+
+@end
+
 @interface TestWidgetLayout : TestCommon <UKTest>
 {
 
@@ -69,5 +84,174 @@
 	UKObjectKindOf([layout tableView], ETTableView);
 }
 
-@end
+- (void) testCachedObjectValues
+{
+	ETLayoutItem *item = [itemFactory item];
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroupWithItems: A(item)];
+	ETTableLayout *layout = [ETTableLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[itemGroup setLayout: layout];
+	[layout setDisplayedProperties: A(kETNameProperty)];
+	[item setName: @"Tic"];
+
+	NSTableColumn *column = (NSTableColumn *)[layout columnForProperty: kETNameProperty];
+
+	UKObjectsEqual(@"Tic", [layout objectValueForTableColumn: column row: 0 item: item]);
+
+	[item setName: @"Tac"];
+
+	UKObjectsEqual(@"Tac", [layout objectValueForTableColumn: column row: 0 item: item]);
+
+	[layout setObjectValue: @"Toe" forTableColumn: column item: item];
+
+	UKObjectsEqual(@"Toe", [item name]);
+	UKObjectsEqual(@"Toe", [layout objectValueForTableColumn: column row: 0 item: item]);
+}
+
+- (void) testUncachedObjectValuesForUnobservableRepresentedObject
+{
+	Person *person = [Person new];
+	ETLayoutItem *item = [itemFactory itemWithRepresentedObject: person];
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroupWithItems: A(item)];
+	ETTableLayout *layout = [ETTableLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[itemGroup setLayout: layout];
+	[layout setDisplayedProperties: A(@"name")];
+
+	NSTableColumn *column = (NSTableColumn *)[layout columnForProperty: @"name"];
+
+	UKObjectsEqual(@"John", [layout objectValueForTableColumn: column row: 0 item: item]);
+	UKIntsEqual(0, [layout cachedItemCount]);
+
+	/* Not reported to the layout, since Person has no observable key paths */
+	[person setName: @"Mike"];
+
+	UKObjectsEqual(@"Mike", [layout objectValueForTableColumn: column row: 0 item: item]);
+}
+
+- (void) testCachedObjectValuesLimit
+{
+	NSMutableArray *items = [NSMutableArray array];
+
+	for (int i = 0; i < 200; i++)
+	{
+		[items addObject: [itemFactory item]];
+	}
+
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroupWithItems: items];
+	ETTableLayout *layout = [ETTableLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[itemGroup setLayout: layout];
+	[layout setDisplayedProperties: A(kETNameProperty)];
+
+	NSTableColumn *column = (NSTableColumn *)[layout columnForProperty: kETNameProperty];
+
+	for (int i = 0; i < 200; i++)
+	{
+		[layout objectValueForTableColumn: column row: i item: items[i]];
+	}
+
+	UKTrue([layout cachedItemCount] > 0);
+	UKTrue([layout cachedItemCount] < 200);
+}
 
+- (void) testCachedObjectValuesForRemovedItem
+{
+	ETLayoutItem *item = [itemFactory item];
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroupWithItems: A([itemFactory item], item)];
+	ETTableLayout *layout = [ETTableLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[itemGroup setLayout: layout];
+	[layout setDisplayedProperties: A(kETNameProperty)];
+	[item setName: @"Tic"];
+	[itemGroup updateLayout];
+
+	NSTableColumn *column = (NSTableColumn *)[layout columnForProperty: kETNameProperty];
+
+	UKObjectsEqual(@"Tic", [layout objectValueForTableColumn: column row: 1 item: item]);
+
+	[itemGroup removeItem: item];
+	/* Not reported to the layout, since the item has no parent */
+	[item setName: @"Tac"];
+	[itemGroup addItem: item];
+
+	UKObjectsEqual(@"Tac", [layout objectValueForTableColumn: column row: 1 item: item]);
+}
+
+- (void) testCachedObjectValuesWithNewLayout
+{
+	ETLayoutItem *item = [itemFactory item];
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroupWithItems: A(item)];
+	ETTableLayout *layout = [ETTableLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]];
+
+	[itemGroup setLayout: [ETTableLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]]];
+	[item setName: @"Tic"];
+	[itemGroup setLayout: layout];
+	[layout setDisplayedProperties: A(kETNameProperty)];
+
+	NSTableColumn *column = (NSTableColumn *)[layout columnForProperty: kETNameProperty];
+
+	UKObjectsSame(layout, [item opaqueLayoutForValueChanges]);
+	UKObjectsEqual(@"Tic", [layout objectValueForTableColumn: column row: 0 item: item]);
+
+	[item setName: @"Tac"];
+
+	UKObjectsEqual(@"Tac", [layout objectValueForTableColumn: column row: 0 item: item]);
+
+	[itemGroup removeItem: item];
+
+	UKNil([item opaqueLayoutForValueChanges]);
+}
+
+- (void) testContentChangesForRowUpdates
+{
+	ETLayoutItem *a = [itemFactory item];
+	ETLayoutItem *b = [itemFactory item];
+	ETLayoutItem *c = [itemFactory item];
+	ETLayoutItem *d = [itemFactory item];
+	ETLayoutItem *e = [itemFactory item];
+	ETLayoutItem *x = [itemFactory item];
+	ETLayoutItem *y = [itemFactory item];
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroupWithItems: A(a, b, c, d, e)];
+
+	[itemGroup setLayout: [ETTableLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]]];
+	[itemGroup updateLayout];
+
+	UKIntsEqual(0, [[itemGroup insertedItemIndexes] count]);
+	UKIntsEqual(0, [[itemGroup removedItemIndexes] count]);
+
+	[itemGroup removeItem: b];
+	[itemGroup insertItem: x atIndex: 0];
+	[itemGroup addItem: y];
+	[itemGroup removeItem: y];
+	[itemGroup removeItem: d];
+
+	UKObjectsEqual(A(x, a, c, e), [itemGroup items]);
+	UKObjectsEqual([NSIndexSet indexSetWithIndex: 0], [itemGroup insertedItemIndexes]);
+
+	NSMutableIndexSet *removedIndexes = [NSMutableIndexSet indexSetWithIndex: 1];
+	[removedIndexes addIndex: 3];
+
+	UKObjectsEqual(removedIndexes, [itemGroup removedItemIndexes]);
+
+	[itemGroup updateLayout];
+
+	UKIntsEqual(0, [[itemGroup insertedItemIndexes] count]);
+	UKIntsEqual(0, [[itemGroup removedItemIndexes] count]);
+}
+
+- (void) testUntrackedContentChanges
+{
+	ETLayoutItemGroup *itemGroup = [itemFactory itemGroupWithItems: A([itemFactory item])];
+
+	[itemGroup setLayout: [ETTableLayout layoutWithObjectGraphContext: [itemFactory objectGraphContext]]];
+	[itemGroup updateLayout];
+	[itemGroup addItem: [itemFactory item]];
+	[itemGroup sortWithSortDescriptors: A([NSSortDescriptor sortDescriptorWithKey: @"name" ascending: YES]) 
+	                       recursively: NO];
+
+	UKNil([itemGroup insertedItemIndexes]);
+	UKNil([itemGroup removedItemIndexes]);
+}
+
+@end
@@ -31,12 +31,18 @@ move, translate and drag behaviors. */
 	NSPoint _dragStartLoc;
 	/** Expressed in the screen base with non-flipped coordinates */	
 	NSPoint _lastDragLoc; 
+	/** Expressed in the screen base with non-flipped coordinates */
+	NSPoint _pendingDragLoc;
+	BOOL _hasPendingDragLoc;
+	BOOL _isTranslationScheduled;
 	BOOL _shouldProduceTranslateActions;
+	BOOL _coalescesDragEvents;
 }
 
 /** @taskunit Interaction Settings */
 
 @property (nonatomic) BOOL shouldProduceTranslateActions;
+@property (nonatomic) BOOL coalescesDragEvents;
 
 /** @taskunit Event Handlers */
 
@@ -53,6 +59,7 @@ move, translate and drag behaviors. */
 - (void) beginTranslateItem: (ETLayoutItem *)item atPoint: (NSPoint)aPoint;
 - (void) translateToPoint: (NSPoint)eventLoc;
 - (void) translateByDelta: (NSSize)aDelta;
+- (void) translateToPendingPoint;
 - (void) endTranslate;
 @property (nonatomic, getter=isTranslating, readonly) BOOL translating;
 
@@ -31,6 +31,7 @@
 
 	[self setCursorName: kETToolCursorNameOpenHand];
 	_shouldProduceTranslateActions = YES;
+	_coalescesDragEvents = YES;
 	return self;
 }
 
@@ -66,6 +67,30 @@ See also -shouldProduceTranslateActions. */
 	_shouldProduceTranslateActions = translate;
 }
 
+/** Returns whether the drag events received during a translation are 
+coalesced into a single translation per run loop pass.
+
+-mouseDragged: only accumulates the pointer location. The item is then 
+translated once by the accumulated delta, when the run loop has processed the 
+queued events and before the windows are redisplayed. The translated item is 
+thus moved, redisplayed (the union of its old and new bounding frames is 
+invalidated once) and relayouted once per frame, rather than once per drag 
+event.
+
+By default, returns YES. */
+- (BOOL) coalescesDragEvents
+{
+	return _coalescesDragEvents;
+}
+
+/** Sets whether the drag events received during a translation are coalesced.
+
+See also -coalescesDragEvents. */
+- (void) setCoalescesDragEvents: (BOOL)coalesce
+{
+	_coalescesDragEvents = coalesce;
+}
+
 #pragma mark Event Handlers -
 
 /* Passes events only to the decorator items bound to the target item.
@@ -104,9 +129,31 @@ when they are expected to. */
 	}
 }
 
-/** Initiates a new translation or updates a translation underway. */
+/** Initiates a new translation or updates a translation underway.
+
+When -coalescesDragEvents returns YES, the translation underway is postponed 
+until the end of the run loop pass (see -translateToPendingPoint). */
 - (void) mouseDragged: (ETEvent *)anEvent
 {
+	/* Don't hit test for each drag event during a translation */
+	if ([self isTranslating])
+	{
+		// FIXME: Should be in screen coordinates...
+		_pendingDragLoc = [anEvent locationInWindow];
+		_hasPendingDragLoc = YES;
+
+		if ([self coalescesDragEvents])
+		{
+			[self scheduleTranslateToPendingPoint];
+		}
+		else
+		{
+			[self translateToPendingPoint];
+		}
+		[anEvent markAsDelivered];
+		return;
+	}
+
 	ETLayoutItem *hitItem = [self hitTestWithEvent: anEvent];
 
 	BOOL isBackgroundHit = [hitItem isEqual: [self targetItem]];
@@ -127,11 +174,6 @@ when they are expected to. */
 		}
 		[anEvent markAsDelivered];
 	}
-	else if ([self isTranslating])
-	{
-		[self translateToPoint: [anEvent locationInWindow]]; // FIXME: Should be in screen coordinates...
-		[anEvent markAsDelivered];
-	}
 	else /* Try deliver the event to a target item decorator */
 	{
 		[self trySendEventToWidgetView: anEvent];
@@ -197,16 +239,71 @@ This method can be overriden to alter the broadcast. */
 	// TODO: Post translate notification
 }
 
+/* The run loop modes in which a postponed translation is applied */
+static NSArray *translationRunLoopModes(void)
+{
+	return @[NSDefaultRunLoopMode, NSModalPanelRunLoopMode, NSEventTrackingRunLoopMode];
+}
+
+/* Schedules -translateToPendingPoint once for the current run loop pass, 
+whatever the number of drag events received in the meantime. */
+- (void) scheduleTranslateToPendingPoint
+{
+	if (_isTranslationScheduled)
+		return;
+
+	_isTranslationScheduled = YES;
+	[[NSRunLoop currentRunLoop] performSelector: @selector(translateToPendingPoint)
+	                                     target: self
+	                                   argument: nil
+	                                      order: 0
+	                                      modes: translationRunLoopModes()];
+}
+
+- (void) cancelTranslateToPendingPoint
+{
+	if (_isTranslationScheduled == NO)
+		return;
+
+	_isTranslationScheduled = NO;
+	[[NSRunLoop currentRunLoop] cancelPerformSelector: @selector(translateToPendingPoint)
+	                                           target: self
+	                                         argument: nil];
+}
+
+/** Translates the item, on which the receiver is currently acting upon, to the 
+last point recorded by -mouseDragged:.
+
+Does nothing when no drag event was received since the last translation.
+
+See -coalescesDragEvents. */
+- (void) translateToPendingPoint
+{
+	[self cancelTranslateToPendingPoint];
+
+	if (_hasPendingDragLoc == NO || [self isTranslating] == NO)
+		return;
+
+	_hasPendingDragLoc = NO;
+	[self translateToPoint: _pendingDragLoc];
+}
+
 - (void) clearMoveState
 {
+	[self cancelTranslateToPendingPoint];
 	_draggedItem = nil;
 	_dragStartLoc = NSZeroPoint;
 	_lastDragLoc = NSZeroPoint;
+	_pendingDragLoc = NSZeroPoint;
+	_hasPendingDragLoc = NO;
 }
 
-/** Ends the translation. */
+/** Ends the translation.
+
+A translation postponed by -mouseDragged: is applied first. */
 - (void) endTranslate
 {
+	[self translateToPendingPoint];
 	[[_draggedItem actionHandler] endTranslateItem: _draggedItem];
 
 	ETAssert(_shouldProduceTranslateActions);
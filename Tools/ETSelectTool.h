@@ -10,7 +10,7 @@
 #import <EtoileUI/ETGraphicsBackend.h>
 #import <EtoileUI/ETMoveTool.h>
 
-@class ETSelectionAreaItem;
+@class ETSelectionAreaItem, ETSpatialIndex;
 
 /** @group Tools
 
@@ -72,6 +72,11 @@ to return NO.
 	NSPoint _localStartDragLoc;
 	/** Expressed in hit/background item base with non-flipped coordinates */
 	NSPoint _localLastDragLoc;
+	/** The last rect used to update the selection in -resizeSelectionAreaToRect: */
+	NSRect _lastSelectionRect;
+	BOOL _hasLastSelectionRect;
+	/** Indexes the background item children when it doesn't use a spatial index */
+	ETSpatialIndex *_selectionAreaIndex;
 }
 
 // TODO: Decide whether we should support...
@@ -18,9 +18,11 @@
 #import "ETActionHandler.h"
 #import "ETLayoutItem.h"
 #import "ETLayoutItemGroup.h"
+#import "ETLayoutItemGroup+Private.h"
 #import "ETLayoutItemFactory.h"
 #import "ETLayout.h"
 #import "ETSelectionAreaItem.h"
+#import "ETSpatialIndex.h"
 #import "ETWidgetLayout.h"
 #import "ETCompatibility.h"
 
@@ -235,6 +237,13 @@ returnedItemRelativePoint is a point in the window frame rect. */
 	if ([anEvent wasDelivered])
 		return;
 
+	/* Don't hit test for each drag event during a translation */
+	if ([self isTranslating] && [self isSelectingArea] == NO)
+	{
+		[super mouseDragged: anEvent];
+		return;
+	}
+
 	// FIXME: Something more sensible [layoutOwner item] (or windowContentItem or rootItem), 
 	// for the last two cases, it's better to do it only if those items have 
 	// ETSelectTool attached to their layout.
@@ -468,6 +477,8 @@ be reactivated when we exit our owner layout. */
 
 	_newSelectionAreaUnderway = YES;
 	_localStartDragLoc = aPoint;
+	_hasLastSelectionRect = NO;
+	_selectionAreaIndex = nil;
 	/* The layer item is mapped to backgroundItem extent, so their coordinate 
 	   space are equal. */
 	[[self selectionAreaItem] setFrame: ETMakeRect(_localStartDragLoc, NSZeroSize)];
@@ -476,6 +487,78 @@ be reactivated when we exit our owner layout. */
 	[(ETLayoutItemGroup *)[backgroundLayout layerItem] addItem: [self selectionAreaItem]];
 }
 
+/* Puts in rects the parts of aRect outside of excludedRect, and returns the 
+number of these parts (at most 4). */
+static NSUInteger ETRectsByExcludingRect(NSRect aRect, NSRect excludedRect, NSRect rects[4])
+{
+	NSRect overlap = NSIntersectionRect(aRect, excludedRect);
+	NSUInteger count = 0;
+
+	if (NSIsEmptyRect(aRect))
+		return 0;
+
+	if (NSIsEmptyRect(overlap))
+	{
+		rects[0] = aRect;
+		return 1;
+	}
+
+	CGFloat minX = NSMinX(aRect), maxX = NSMaxX(aRect);
+	CGFloat minY = NSMinY(aRect), maxY = NSMaxY(aRect);
+
+	/* Full width strips below and above the overlap */
+	if (NSMinY(overlap) > minY)
+	{
+		rects[count++] = NSMakeRect(minX, minY, maxX - minX, NSMinY(overlap) - minY);
+	}
+	if (NSMaxY(overlap) < maxY)
+	{
+		rects[count++] = NSMakeRect(minX, NSMaxY(overlap), maxX - minX, maxY - NSMaxY(overlap));
+	}
+	/* Strips on the left and right of the overlap */
+	if (NSMinX(overlap) > minX)
+	{
+		rects[count++] = NSMakeRect(minX, NSMinY(overlap), NSMinX(overlap) - minX, NSHeight(overlap));
+	}
+	if (NSMaxX(overlap) < maxX)
+	{
+		rects[count++] = NSMakeRect(NSMaxX(overlap), NSMinY(overlap), maxX - NSMaxX(overlap), NSHeight(overlap));
+	}
+	return count;
+}
+
+/* Returns the spatial index to look up the background item children, either 
+the one maintained by the background item or one built for the selection area 
+underway. */
+- (ETSpatialIndex *) selectionAreaIndexForItem: (ETLayoutItemGroup *)backgroundItem
+{
+	ETSpatialIndex *spatialIndex = [backgroundItem spatialIndex];
+
+	if (spatialIndex != nil)
+		return spatialIndex;
+
+	if (_selectionAreaIndex == nil)
+	{
+		NSArray *items = [backgroundItem items];
+		NSUInteger nbOfItems = [items count];
+
+		_selectionAreaIndex = [ETSpatialIndex new];
+
+		for (NSUInteger i = 0; i < nbOfItems; i++)
+		{
+			ETLayoutItem *item = items[i];
+			[_selectionAreaIndex setRect: [item frame] order: i forItem: item];
+		}
+	}
+	return _selectionAreaIndex;
+}
+
+/** Updates the selection area to the given rect, then the selected items based 
+on their intersection with the new selection rect.
+
+Only the items that intersect the band between the previous and the new 
+selection rect are selected or deselected, and are looked up with a spatial 
+index rather than visiting every child. See -[ETLayoutItemGroup usesSpatialIndex]. */
 - (void) resizeSelectionAreaToRect: (NSRect)aRect
 {
 	ETDebugLog(@"Resize selection to rect %@", NSStringFromRect(aRect));
@@ -486,12 +569,37 @@ be reactivated when we exit our owner layout. */
 	   flipped coordinates or not, doesn't matter to compute and standardize 
 	   the new selection rect. */
 	NSRect newSelectionRect = ETStandardizeRect(aRect);
+	NSRect oldSelectionRect = (_hasLastSelectionRect ? _lastSelectionRect : NSZeroRect);
 
 	[[self selectionAreaItem] setNeedsDisplay: YES]; /* Invalid existing rect */
 	[[self selectionAreaItem] setFrame: newSelectionRect];
 	[[self selectionAreaItem] setNeedsDisplay: YES]; /* Invalid new rect */
 
-	FOREACHI([backgroundItem items], childItem)
+	ETSpatialIndex *spatialIndex = [self selectionAreaIndexForItem: backgroundItem];
+	NSHashTable *changedItems = [NSHashTable hashTableWithOptions: NSPointerFunctionsObjectPointerPersonality];
+	NSRect bandRects[8];
+	NSUInteger nbOfBandRects = ETRectsByExcludingRect(newSelectionRect, oldSelectionRect, bandRects);
+
+	nbOfBandRects += ETRectsByExcludingRect(oldSelectionRect, newSelectionRect, &bandRects[nbOfBandRects]);
+
+	/* The items selected before the selection area began are deselected when 
+	   they are outside the selection rect */
+	if (_hasLastSelectionRect == NO)
+	{
+		for (ETLayoutItem *item in [backgroundItem selectedItems])
+		{
+			[changedItems addObject: item];
+		}
+	}
+	for (NSUInteger i = 0; i < nbOfBandRects; i++)
+	{
+		for (ETLayoutItem *item in [spatialIndex itemsIntersectingRect: bandRects[i]])
+		{
+			[changedItems addObject: item];
+		}
+	}
+
+	for (ETLayoutItem *childItem in changedItems)
 	{
 		if (NSIntersectsRect([childItem frame], newSelectionRect))
 		{
@@ -503,7 +611,11 @@ be reactivated when we exit our owner layout. */
 		}
 	}
 
-	/* Now redisplay both selection area and newly selected/unselected items */
+	_lastSelectionRect = newSelectionRect;
+	_hasLastSelectionRect = YES;
+
+	/* Now redisplay both selection area and newly selected/unselected items, 
+	   -displayIfNeeded only redraws the invalidated rects */
 	[[self targetItem] displayIfNeeded];
 }
 
@@ -531,6 +643,9 @@ their intersection with the new selection rect. */
 	[(ETLayoutItemGroup *)[backgroundLayout layerItem] removeItem: [self selectionAreaItem]];
 	_newSelectionAreaUnderway = NO;
 	_localStartDragLoc = NSZeroPoint; /* Debugging hint */
+	_lastSelectionRect = NSZeroRect;
+	_hasLastSelectionRect = NO;
+	_selectionAreaIndex = nil;
 
 	/* Now redisplay the last selection area to erase it */
 	[[self targetItem] displayIfNeeded];
@@ -680,15 +795,40 @@ item will be selected. */
 	}
 }
 
-/** Tells each item currently selected in the target item to deselect itself. */
+/* Returns the given items grouped by action handler. */
+- (NSMapTable *) itemsByActionHandlerForItems: (NSArray *)items
+{
+	NSMapTable *itemsByHandler = [NSMapTable mapTableWithKeyOptions: NSPointerFunctionsObjectPointerPersonality
+	                                                   valueOptions: NSPointerFunctionsStrongMemory];
+
+	for (ETLayoutItem *item in items)
+	{
+		ETActionHandler *handler = [item actionHandler];
+		NSMutableArray *handlerItems = [itemsByHandler objectForKey: handler];
+
+		if (handlerItems == nil)
+		{
+			handlerItems = [NSMutableArray array];
+			[itemsByHandler setObject: handlerItems forKey: handler];
+		}
+		[handlerItems addObject: item];
+	}
+	return itemsByHandler;
+}
+
+/** Deselects every item currently selected in the target item.
+
+The selected items are passed to -[ETActionHandler handleDeselectItems:], once 
+per action handler, so the selection can be changed in a single pass. */
 - (void) deselectAllWithItem: (ETLayoutItem *)item
 {
-	/* Deselect all */
-	for (ETLayoutItem *selectedItem in [self selectedItems])
+	NSMapTable *itemsByHandler = [self itemsByActionHandlerForItems: [self selectedItems]];
+
+	for (ETActionHandler *handler in itemsByHandler)
 	{
-		[[selectedItem actionHandler] handleDeselect: selectedItem];
+		[handler handleDeselectItems: [itemsByHandler objectForKey: handler]];
 		// NOTE: We should eventually update the controller selection here
-		// rather than in -handleDeselect:
+		// rather than in -handleDeselectItems:
 	}
 }
 
@@ -784,15 +924,27 @@ on the selection elements, when the receiver becomes the first responder. */
 
 #pragma mark Additional Tool Actions -
 
-/** Tells each item currently deselected in the target item to select itself. */
+/** Selects every item in the target item for which -[ETActionHandler canSelect:] 
+returns YES.
+
+The items are passed to -[ETActionHandler handleSelectItems:], once per action 
+handler, so the selection can be changed in a single pass. */
 - (IBAction) selectAll: (id)sender
 {
+	NSMutableArray *selectableItems = [NSMutableArray array];
+
 	for (ETLayoutItem *item in [(ETLayoutItemGroup *)[self targetItem] items])
 	{
 		if ([item isSelected] == NO && [[item actionHandler] canSelect: item])
 		{
-			[[item actionHandler] handleSelect: item];
+			[selectableItems addObject: item];
 		}
+	}
+	NSMapTable *itemsByHandler = [self itemsByActionHandlerForItems: selectableItems];
+
+	for (ETActionHandler *handler in itemsByHandler)
+	{
+		[handler handleSelectItems: [itemsByHandler objectForKey: handler]];
 		// NOTE: We should eventually update the controller selection here...
 	}
 }
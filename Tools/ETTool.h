@@ -97,6 +97,8 @@ double-click and deactivated on a mouse click outside of their layout boundaries
 @property (nonatomic, readonly) ETLayoutItem *hitItemForNil;
 
 - (ETLayoutItem *) hitTestWithEvent: (ETEvent *)anEvent;
+- (ETLayoutItem *) hitTestWithEvent: (ETEvent *)anEvent
+                        lastHitItem: (ETLayoutItem *)lastHitItem;
 - (ETLayoutItem *) hitTest: (NSPoint)itemRelativePoint 
                  withEvent: (ETEvent *)anEvent 
 				    inItem: (ETLayoutItem *)anItem;
@@ -20,9 +20,11 @@
 #import "ETActionHandler.h"
 #import "ETLayoutItem.h"
 #import "ETLayoutItemGroup.h"
+#import "ETLayoutItemGroup+Private.h"
 #import "ETLayoutItemFactory.h"
 #import "ETApplication.h"
 #import "ETLayout.h"
+#import "ETSpatialIndex.h"
 #import "ETView.h"
 #import "ETWindowItem.h"
 // FIXME: Move related code to the Appkit widget backend (perhaps in a category)
@@ -663,6 +665,146 @@ ignored and the local root item is also returned. */
 	return hitItem;
 }
 
+/** Returns the layout item hovered at the mouse location reported by anEvent, 
+by resuming the hit test from the previous hit item.
+
+The path from the window content item to lastHitItem is walked down to find 
+the deepest item that still contains the event location, and the hit test 
+continues from this item with -hitTest:withEvent:inItem:. For small pointer 
+moves, the cost is proportional to the tree depth rather than to the number of 
+items in the tree. For item groups that use a spatial index, the siblings are 
+looked up in the index, see -[ETLayoutItemGroup usesSpatialIndex].
+
+The walk stops above an item whose layout shows layer items, or whose previous 
+siblings contain the location, since -hitTest:withEvent:inChildrenOfItem: 
+gives precedence to them. When lastHitItem is nil, no longer in the window or 
+the location is elsewhere, falls back on -hitTestWithEvent:.
+
+The shortcut skips -willHitTest:withEvent:inItem:newLocation: for the items 
+above the resumed one, so tools that customize the hit test must use 
+-hitTestWithEvent: instead. */
+- (ETLayoutItem *) hitTestWithEvent: (ETEvent *)anEvent
+                        lastHitItem: (ETLayoutItem *)lastHitItem
+{
+	ETLayoutItem *testedItem = [[anEvent contentItem] firstDecoratedItem];
+
+	if (lastHitItem == nil || testedItem == nil)
+		return [self hitTestWithEvent: anEvent];
+
+	BOOL isOutsideItem = (NSMouseInRect([anEvent location], [testedItem frame],
+		[[self hitItemForNil] isFlipped]) == NO);
+
+	if (isOutsideItem)
+		return [self hitTestWithEvent: anEvent];
+
+	ETLayoutItem *hitItem = [[anEvent windowItem] hitTestFieldEditorWithEvent: anEvent];
+	if (hitItem != nil)
+	{
+		return hitItem;
+	}
+
+	NSPoint point = [anEvent locationInWindowItem];
+	ETLayoutItem *startItem = [self deepestItemOnPathFromItem: testedItem
+	                                                   toItem: lastHitItem
+	                                                  atPoint: &point];
+
+	if (startItem == nil)
+		return [self hitTestWithEvent: anEvent];
+
+	hitItem = [self hitTest: point withEvent: anEvent inItem: startItem];
+
+	if (hitItem == nil)
+		return [self hitTestWithEvent: anEvent];
+
+	ETAssert([anEvent layoutItem] == hitItem);
+	return hitItem;
+}
+
+/* Returns whether -hitTest:withEvent:inChildrenOfItem: would look up the 
+explicit children of anItem, without hitting an implicit child first. */
+- (BOOL) canHitTestChildrenOfItem: (ETLayoutItem *)anItem atPoint: (NSPoint)itemRelativePoint
+{
+	if ([anItem isGroup] == NO)
+		return NO;
+
+	ETLayout *layout = [anItem layout];
+	BOOL isInsideActionArea = ([anItem decoratorItemAtPoint: itemRelativePoint] == anItem
+		|| [(ETLayoutItemGroup *)anItem acceptsActionsForItemsOutsideOfFrame]);
+
+	return (isInsideActionArea && (layout == nil
+		|| ([layout isOpaque] == NO && [[layout layerItem] numberOfItems] == 0)));
+}
+
+/* Returns the children of anItem whose bounding box can contain the given point, 
+in -[ETLayoutItemGroup items] order.
+
+When anItem maintains a spatial index, only the children indexed around the 
+point are returned. Otherwise, every child is returned. The index orders the 
+arranged items, so it is only used when they match -items. */
+- (id <NSFastEnumeration>) childItemsOfItem: (ETLayoutItemGroup *)anItem 
+                               nearPoint: (NSPoint)pointInParentContent
+{
+	ETSpatialIndex *spatialIndex = [anItem spatialIndex];
+
+	if (spatialIndex == nil || [anItem isSorted] || [anItem isFiltered])
+		return [anItem items];
+
+	/* The rect is centered on the point, so the children whose max edges 
+	   touch the point are returned too */
+	NSRect pointRect = NSMakeRect(pointInParentContent.x - 0.5, 
+		pointInParentContent.y - 0.5, 1, 1);
+
+	return [[spatialIndex itemsIntersectingRect: pointRect] reverseObjectEnumerator];
+}
+
+/* Returns the deepest item on the path from rootItem down to anItem, where 
+-hitTest:withEvent:inItem: is sure to descend for the given point.
+
+The point must be expressed in rootItem coordinates, and is converted to the 
+returned item coordinates. Returns nil when anItem is not a rootItem descendant, 
+or when rootItem doesn't contain the point. */
+- (ETLayoutItem *) deepestItemOnPathFromItem: (ETLayoutItem *)rootItem
+                                      toItem: (ETLayoutItem *)anItem
+                                     atPoint: (NSPoint *)aPoint
+{
+	if (anItem == nil)
+		return nil;
+
+	if (anItem == rootItem)
+	{
+		BOOL useBoundingBox = ([rootItem windowItem] == nil);
+		return ([rootItem pointInside: *aPoint useBoundingBox: useBoundingBox] ? rootItem : nil);
+	}
+
+	ETLayoutItemGroup *parentItem = [anItem parentItem];
+	ETLayoutItem *ancestorItem =
+		[self deepestItemOnPathFromItem: rootItem toItem: parentItem atPoint: aPoint];
+
+	if (ancestorItem != parentItem || [self canHitTestChildrenOfItem: parentItem atPoint: *aPoint] == NO)
+		return ancestorItem;
+
+	NSPoint pointInParentContent = [parentItem convertRectToContent: ETMakeRect(*aPoint, NSZeroSize)].origin;
+
+	for (ETLayoutItem *siblingItem in [self childItemsOfItem: parentItem nearPoint: pointInParentContent])
+	{
+		if (siblingItem == anItem)
+			break;
+
+		NSPoint siblingRelativePoint = [siblingItem convertPointFromParent: pointInParentContent];
+
+		if ([siblingItem pointInside: siblingRelativePoint useBoundingBox: YES])
+			return parentItem;
+	}
+
+	NSPoint childRelativePoint = [anItem convertPointFromParent: pointInParentContent];
+
+	if ([anItem pointInside: childRelativePoint useBoundingBox: YES] == NO)
+		return parentItem;
+
+	*aPoint = childRelativePoint;
+	return anItem;
+}
+
 /* Does the hit test in:
 - explicit children when the item is an ETLayoutItemGroup
 - implicit children when the item has a layout (both ETLayoutItem and 
@@ -704,7 +846,8 @@ Hence whether or not the item has children, this method will be called. */
 		return anItem;
 
 	/* Hit in explicit children */
-	for (ETLayoutItem *childItem in [(ETLayoutItemGroup *)anItem items])
+	for (ETLayoutItem *childItem in [self childItemsOfItem: (ETLayoutItemGroup *)anItem 
+	                                             nearPoint: pointInParentContent])
 	{
 		NSPoint childRelativePoint = [childItem convertPointFromParent: pointInParentContent];
 		BOOL isInside = [childItem pointInside: childRelativePoint useBoundingBox: YES];
@@ -12,7 +12,7 @@
 #import <Foundation/Foundation.h>
 #import <EtoileUI/ETFlippableView.h>
 
-@class ETLayoutItem, ETUIItem;
+@class ETLayoutItem, ETRenderContext, ETUIItem;
 
 /** ETView is the generic view class extensively used by EtoileUI and whose 
 instance are named 'supervisor view'.
@@ -48,6 +48,8 @@ next EtoileUI release. */
 	BOOL _wasJustRedrawn;
 #endif
 	NSRect _rectToRedraw;
+	ETRenderContext *_renderContext;
+	NSMutableDictionary *_inputValues;
 }
 
 - (SEL) defaultItemFactorySelector;
@@ -83,9 +85,31 @@ Item views are drawn first and pinned subviews are drawn last.
 The subviews to insert are listed in their item order (first views being the 
 last drawn ones), so they will appear reversed in -[NSView subviews]. */
 - (void) setItemViews: (NSArray *)itemViews;
+/** Returns the item views in their item order, without the pinned subviews.
+
+See -setItemViews:. */
+@property (nonatomic, readonly) NSArray *itemViews;
+/** Inserts an item view above the given item view, or below all the other 
+subviews when the latter is nil.
+
+The pinned subviews are left untouched. */
+- (void) insertItemView: (NSView *)aView aboveItemView: (NSView *)viewBelow;
+/** Removes an item view, without altering the order of the other subviews. */
+- (void) removeItemView: (NSView *)aView;
 
 /** @taskunit Drawing */
 
+/** The render context passed to the item when the receiver draws it.
+
+The render context is reset with -[ETRenderContext resetWithInputValues:] each 
+time the receiver starts to redraw.
+
+Never returns nil. */
+@property (nonatomic, strong) ETRenderContext *renderContext;
+/** Deprecated. Use -renderContext.
+
+The key/value pairs put in the render context input values, each time the 
+receiver starts to redraw. */
 @property (nonatomic, strong) NSMutableDictionary *inputValues;
 
 /** @taskunit Actions */
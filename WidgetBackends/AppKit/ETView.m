@@ -14,6 +14,7 @@
 #import "ETLayoutItem.h"
 #import "ETLayoutItem+Private.h"
 #import "ETLayoutItemGroup.h"
+#import "ETRenderContext.h"
 #import "ETUIItemIntegration.h"
 #import "NSObject+EtoileUI.h"
 #import "NSView+EtoileUI.h"
@@ -433,6 +434,44 @@ return the temporary view. */
 	[self validateViewHierarchy];
 }
 
+- (NSArray *) itemViews
+{
+	NSMutableArray *itemViews = [NSMutableArray arrayWithCapacity: self.subviews.count];
+
+	for (NSView *view in self.subviews.reverseObjectEnumerator)
+	{
+		if (view == _wrappedView || view == _temporaryView || view == _foregroundView)
+			continue;
+
+		[itemViews addObject: view];
+	}
+	return itemViews;
+}
+
+- (void) insertItemView: (NSView *)aView aboveItemView: (NSView *)viewBelow
+{
+	NSParameterAssert(aView != _wrappedView && aView != _temporaryView && aView != _foregroundView);
+	NSParameterAssert(viewBelow == nil || [viewBelow superview] == self);
+
+	if (viewBelow == nil)
+	{
+		[self addSubview: aView positioned: NSWindowBelow relativeTo: nil];
+	}
+	else
+	{
+		[self addSubview: aView positioned: NSWindowAbove relativeTo: viewBelow];
+	}
+	[self validateViewHierarchy];
+}
+
+- (void) removeItemView: (NSView *)aView
+{
+	NSParameterAssert([aView superview] == self);
+	NSParameterAssert(aView != _wrappedView && aView != _temporaryView && aView != _foregroundView);
+
+	[aView removeFromSuperview];
+}
+
 /* Actions */
 
 /** Invokes -inspect: action on the receiver item. 
@@ -543,15 +582,50 @@ NSAssert1(size.width >= 0 && size.height >= 0, @"For a supervisor view, the " \
 
 /* Rendering Tree */
 
+- (ETRenderContext *) renderContext
+{
+	if (_renderContext == nil)
+	{
+		_renderContext = [ETRenderContext new];
+	}
+	return _renderContext;
+}
+
+- (void) setRenderContext: (ETRenderContext *)aRenderContext
+{
+	_renderContext = aRenderContext;
+}
+
 - (NSMutableDictionary *) inputValues
 {
 	if (_inputValues == nil)
 	{
-		return [NSMutableDictionary new];
+		_inputValues = [NSMutableDictionary new];
 	}
 	return _inputValues;
 }
 
+- (void) setInputValues: (NSMutableDictionary *)inputValues
+{
+	_inputValues = inputValues;
+}
+
+/* Returns the number of device pixels per point for the window, or 1 when the 
+receiver is not in a window. */
+- (CGFloat) windowScaleFactor
+{
+	NSWindow *window = [self window];
+
+	if (window == nil)
+		return 1;
+
+#ifdef GNUSTEP
+	return [window userSpaceScaleFactor];
+#else
+	return [window backingScaleFactor];
+#endif
+}
+
 #ifdef DEBUG_DRAWING
 
 - (void) drawInvalidatedAreaWithRect: (NSRect)needsDisplayRect
@@ -595,9 +669,13 @@ Layout items are smart enough to avoid drawing their view when they have one. */
 	if (!item.isLayoutItem)
 		return;
 
+	/* Each redraw starts a new frame */
+	[self.renderContext resetWithInputValues: _inputValues];
+	[self.renderContext setScaleFactor: [self windowScaleFactor]];
+
 	/* When drawing the content, the dirty rect can be left unchanged, because
 	   it already orresponds to the content drawing box */
-	[(ETLayoutItem *)item renderBackground: self.inputValues
+	[(ETLayoutItem *)item renderBackground: self.renderContext
 	                             dirtyRect: dirtyRect
 	                             inContext: nil];
 }
@@ -624,7 +702,7 @@ the title bar, . */
 
 	/* Draw the layer item style in the item content coordinate space */
 
-	[layerItem renderBackground: self.inputValues
+	[layerItem renderBackground: self.renderContext
 	                  dirtyRect: dirtyRect
 	                  inContext: nil];
 
@@ -633,18 +711,17 @@ the title bar, . */
 	NSRect drawingBox = ((ETLayoutItem *)item).drawingBox;
 	// FIXME: NSRect adjustedDirtyRect = [self adjustedDirtyRect: dirtyRect inDrawingBox: drawingBox];
 	NSRect adjustedDirtyRect = drawingBox;
-	NSAffineTransform *transform = [NSAffineTransform transform];
 	NSPoint contentOriginInBounds = [self adjustedOriginInDrawingBox: drawingBox];
+	NSAffineTransformStruct transform = 
+		ETTranslatedTransform(ETIdentityTransform(), contentOriginInBounds.x, contentOriginInBounds.y);
 
-	[transform translateXBy: contentOriginInBounds.x yBy: contentOriginInBounds.y];
-	[transform concat];
+	[self.renderContext pushRenderState: (ETRenderState){ transform, ETNullRect }];
 	
-	[(ETLayoutItem *)item renderForeground: self.inputValues
+	[(ETLayoutItem *)item renderForeground: self.renderContext
 	                             dirtyRect: adjustedDirtyRect
 	                             inContext: nil];
 
-	[transform invert];
-	[transform concat];
+	[self.renderContext popRenderState];
 }
 
 - (NSRect) dirtyRect
@@ -14,7 +14,7 @@
 
 // FIXME: Don't expose NSView and NSWindow in the public API.
 @class NSView, NSWindow;
-@class ETEvent, ETUIItem, ETLayoutItem;
+@class ETEvent, ETTool, ETUIItem, ETLayoutItem;
 
 /** The active tool handles the dispatch in the layout item tree. */
 @interface ETEventProcessor : NSObject
@@ -89,6 +89,8 @@ extern NSString * const ETEventProcessorDidProcessEventNotification;
 {
 	@private
 	ETLayoutItem *_lastHoveredItem;
+	ETTool *_hoverTool;
+	ETLayoutItem * __weak _lastHitItem;
 	NSWindow *_initialKeyWindow;
 	id _initialFirstResponder;
 	BOOL _wasMouseDownProcessed;
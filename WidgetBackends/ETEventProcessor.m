@@ -333,9 +333,16 @@ is the root item which contains both A and D.
 - (void) processMouseMovedEvent: (ETEvent *)anEvent
 {
 	ETTool *tool = [ETTool activeTool];
-	ETLayoutItem *hitItem =
-		[[ETTool toolWithObjectGraphContext: [ETUIObject defaultTransientObjectGraphContext]]
-			hitTestWithEvent: anEvent];
+
+	/* A basic tool doesn't customize the hit test, so the hit test can resume 
+	   from the last hit item (see -[ETTool hitTestWithEvent:lastHitItem:]) */
+	if (_hoverTool == nil)
+	{
+		_hoverTool = [ETTool toolWithObjectGraphContext: [ETUIObject defaultTransientObjectGraphContext]];
+	}
+	ETLayoutItem *hitItem = [_hoverTool hitTestWithEvent: anEvent lastHitItem: _lastHitItem];
+
+	_lastHitItem = hitItem;
 
 	//ETLog(@"Will process mouse move on %@ and hovered item stack\n %@", 
 	//	hitItem, [tool hoveredItemStackForItem: hitItem]);